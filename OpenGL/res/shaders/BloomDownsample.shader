@@ -0,0 +1,44 @@
+#shader vertex
+#version 330 core
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// One triangle that covers the whole screen, no vertex buffer needed
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Source;
+uniform vec2 u_TexelSize; // of the source
+uniform int u_Prefilter;
+uniform float u_Threshold;
+
+void main()
+{
+	// Dual filter downsample: the centre plus four bilinear taps on the
+	// diagonals, each averaging a 2x2 block of the source
+	vec3 sum = texture(u_Source, v_TexCoord).rgb * 4.0;
+	sum += texture(u_Source, v_TexCoord + vec2(-u_TexelSize.x, -u_TexelSize.y)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2( u_TexelSize.x, -u_TexelSize.y)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2(-u_TexelSize.x,  u_TexelSize.y)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2( u_TexelSize.x,  u_TexelSize.y)).rgb;
+	sum /= 8.0;
+
+	// The first level only keeps what is brighter than the threshold
+	if (u_Prefilter != 0)
+	{
+		float brightness = max(sum.r, max(sum.g, sum.b));
+		sum *= max(brightness - u_Threshold, 0.0) / max(brightness, 0.0001);
+	}
+	color = vec4(sum, 1.0);
+}
@@ -0,0 +1,39 @@
+#shader vertex
+#version 330 core
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// One triangle that covers the whole screen, no vertex buffer needed
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Source;  // the level below
+uniform sampler2D u_Current; // the down target of this level
+uniform vec2 u_TexelSize;    // of the source
+
+void main()
+{
+	// Dual filter upsample of the level below: a ring of eight taps, the
+	// diagonals weighted double, added to this level
+	vec2 offset = u_TexelSize;
+	vec3 sum = texture(u_Source, v_TexCoord + vec2(-offset.x * 2.0, 0.0)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2( offset.x * 2.0, 0.0)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2(0.0, -offset.y * 2.0)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2(0.0,  offset.y * 2.0)).rgb;
+	sum += texture(u_Source, v_TexCoord + vec2(-offset.x, -offset.y)).rgb * 2.0;
+	sum += texture(u_Source, v_TexCoord + vec2( offset.x, -offset.y)).rgb * 2.0;
+	sum += texture(u_Source, v_TexCoord + vec2(-offset.x,  offset.y)).rgb * 2.0;
+	sum += texture(u_Source, v_TexCoord + vec2( offset.x,  offset.y)).rgb * 2.0;
+	color = vec4(sum / 12.0 + texture(u_Current, v_TexCoord).rgb, 1.0);
+}
@@ -0,0 +1,55 @@
+#shader compute
+#version 430 core
+
+layout(local_size_x = 64) in;
+
+struct Instance
+{
+	mat4 model;
+	uint meshIndex;
+	uint padding0;
+	uint padding1;
+	uint padding2;
+};
+
+struct DrawCommand
+{
+	uint count;
+	uint instanceCount;
+	uint firstIndex;
+	int  baseVertex;
+	uint baseInstance;
+};
+
+layout(std430, binding = 0) readonly buffer Instances { Instance instances[]; };
+// xyz = centre, w = radius
+layout(std430, binding = 1) readonly buffer Bounds { vec4 bounds[]; };
+layout(std430, binding = 2) buffer Commands { DrawCommand commands[]; };
+layout(std430, binding = 3) writeonly buffer Visible { uint visible[]; };
+
+uniform vec4 u_Planes[6];
+uniform uint u_InstanceCount;
+
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if (id >= u_InstanceCount)
+		return;
+
+	mat4 model = instances[id].model;
+	uint mesh = instances[id].meshIndex;
+	vec4 sphere = bounds[mesh];
+
+	vec3 center = (model * vec4(sphere.xyz, 1.0)).xyz;
+	float scale = max(length(model[0].xyz), max(length(model[1].xyz), length(model[2].xyz)));
+	float radius = sphere.w * scale;
+
+	for (int i = 0; i < 6; i++)
+	{
+		if (dot(u_Planes[i].xyz, center) + u_Planes[i].w < -radius)
+			return;
+	}
+
+	uint slot = atomicAdd(commands[mesh].instanceCount, 1u);
+	visible[commands[mesh].baseInstance + slot] = id;
+}
@@ -0,0 +1,65 @@
+#shader vertex
+#version 330 core
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// One triangle that covers the whole screen, no vertex buffer needed
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Source;
+uniform vec2 u_TexelSize;
+
+#define FXAA_REDUCE_MIN (1.0 / 128.0)
+#define FXAA_REDUCE_MUL (1.0 / 8.0)
+#define FXAA_SPAN_MAX   8.0
+
+// The compact PC version of Timothy Lottes' FXAA: find the edge direction
+// from the luma of the four diagonal neighbours, then blur along it
+void main()
+{
+	const vec3 toLuma = vec3(0.299, 0.587, 0.114);
+	vec3 rgbNW = texture(u_Source, v_TexCoord + vec2(-1.0, -1.0) * u_TexelSize).rgb;
+	vec3 rgbNE = texture(u_Source, v_TexCoord + vec2( 1.0, -1.0) * u_TexelSize).rgb;
+	vec3 rgbSW = texture(u_Source, v_TexCoord + vec2(-1.0,  1.0) * u_TexelSize).rgb;
+	vec3 rgbSE = texture(u_Source, v_TexCoord + vec2( 1.0,  1.0) * u_TexelSize).rgb;
+	vec3 rgbM  = texture(u_Source, v_TexCoord).rgb;
+
+	float lumaNW = dot(rgbNW, toLuma);
+	float lumaNE = dot(rgbNE, toLuma);
+	float lumaSW = dot(rgbSW, toLuma);
+	float lumaSE = dot(rgbSE, toLuma);
+	float lumaM  = dot(rgbM, toLuma);
+	float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+	float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+
+	vec2 direction;
+	direction.x = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+	direction.y =  ((lumaNW + lumaSW) - (lumaNE + lumaSE));
+
+	float reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25 * FXAA_REDUCE_MUL), FXAA_REDUCE_MIN);
+	float scale = 1.0 / (min(abs(direction.x), abs(direction.y)) + reduce);
+	direction = clamp(direction * scale, vec2(-FXAA_SPAN_MAX), vec2(FXAA_SPAN_MAX)) * u_TexelSize;
+
+	vec3 rgbA = 0.5 * (
+		texture(u_Source, v_TexCoord + direction * (1.0 / 3.0 - 0.5)).rgb +
+		texture(u_Source, v_TexCoord + direction * (2.0 / 3.0 - 0.5)).rgb);
+	vec3 rgbB = rgbA * 0.5 + 0.25 * (
+		texture(u_Source, v_TexCoord + direction * -0.5).rgb +
+		texture(u_Source, v_TexCoord + direction * 0.5).rgb);
+
+	// The wider sample strayed off the edge, fall back to the narrow one
+	float lumaB = dot(rgbB, toLuma);
+	color = vec4((lumaB < lumaMin || lumaB > lumaMax) ? rgbA : rgbB, 1.0);
+}
@@ -0,0 +1,49 @@
+#shader vertex
+#version 430 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+// Written by the cull shader, offset per draw by the command's baseInstance
+layout(location = 2) in uint instanceIndex;
+
+struct Instance
+{
+	mat4 model;
+	uint meshIndex;
+	uint padding0;
+	uint padding1;
+	uint padding2;
+};
+
+layout(std430, binding = 0) readonly buffer Instances { Instance instances[]; };
+
+out vec2 v_TexCoord;
+flat out vec4 v_Color;
+
+uniform mat4 u_ViewProjection;
+
+void main()
+{
+	gl_Position = u_ViewProjection * instances[instanceIndex].model * position;
+	v_TexCoord = texCoord;
+
+	// Cheap per instance tint so neighbouring instances can be told apart
+	uint h = instanceIndex * 2654435761u;
+	v_Color = vec4(0.5 + 0.5 * vec3(h & 255u, (h >> 8) & 255u, (h >> 16) & 255u) / 255.0, 1.0);
+}
+
+#shader fragment
+#version 430 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+flat in vec4 v_Color;
+
+uniform sampler2D u_Texture;
+
+void main()
+{
+	vec4 texColor = texture(u_Texture, v_TexCoord);
+	color = texColor * v_Color;
+}
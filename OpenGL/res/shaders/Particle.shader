@@ -0,0 +1,32 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 corner;
+// Per instance
+layout(location = 1) in vec4 positionLife;
+
+out vec4 v_Color;
+
+uniform mat4 u_ViewProjection;
+uniform float u_Size;
+uniform float u_Lifetime;
+
+void main()
+{
+	gl_Position = u_ViewProjection * vec4(positionLife.xyz + vec3(corner * u_Size, 0.0), 1.0);
+
+	float t = clamp(positionLife.w / u_Lifetime, 0.0, 1.0);
+	v_Color = mix(vec4(1.0, 0.2, 0.05, 0.0), vec4(1.0, 0.9, 0.5, 1.0), t);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
@@ -0,0 +1,59 @@
+#shader compute
+#version 430 core
+
+layout(local_size_x = 256) in;
+
+struct Particle
+{
+	// w = remaining life in seconds
+	vec4 positionLife;
+	// w = -1 so integrating the position also counts life down
+	vec4 velocity;
+};
+
+layout(std430, binding = 0) buffer Particles { Particle particles[]; };
+
+uniform uint u_Count;
+uniform uint u_Seed;
+uniform float u_DeltaTime;
+uniform float u_Lifetime;
+uniform float u_Speed;
+uniform vec3 u_Emitter;
+uniform vec3 u_Gravity;
+
+// Must match ParticleSystem.cpp and ParticleFeedback.shader
+uint Hash(uint x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+float Random(uint id, uint k)
+{
+	return float(Hash(id * 3u + k + Hash(u_Seed))) / 4294967295.0;
+}
+
+void main()
+{
+	uint id = gl_GlobalInvocationID.x;
+	if (id >= u_Count)
+		return;
+
+	Particle p = particles[id];
+	p.velocity.xyz += u_Gravity * u_DeltaTime;
+	p.positionLife += p.velocity * u_DeltaTime;
+
+	if (p.positionLife.w <= 0.0)
+	{
+		float angle = mix(-0.35, 0.35, Random(id, 0u));
+		float speed = u_Speed * mix(0.5, 1.0, Random(id, 1u));
+		p.positionLife = vec4(u_Emitter, u_Lifetime * mix(0.25, 1.0, Random(id, 2u)));
+		p.velocity = vec4(sin(angle) * speed, cos(angle) * speed, 0.0, -1.0);
+	}
+
+	particles[id] = p;
+}
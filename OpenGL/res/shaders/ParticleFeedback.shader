@@ -0,0 +1,51 @@
+#shader vertex
+#version 330 core
+
+// Same layout as ParticleCompute.shader, read from one buffer and
+// captured into the other with transform feedback
+layout(location = 1) in vec4 positionLife;
+layout(location = 2) in vec4 velocity;
+
+out vec4 o_PositionLife;
+out vec4 o_Velocity;
+
+uniform uint u_Seed;
+uniform float u_DeltaTime;
+uniform float u_Lifetime;
+uniform float u_Speed;
+uniform vec3 u_Emitter;
+uniform vec3 u_Gravity;
+
+uint Hash(uint x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+float Random(uint id, uint k)
+{
+	return float(Hash(id * 3u + k + Hash(u_Seed))) / 4294967295.0;
+}
+
+void main()
+{
+	uint id = uint(gl_VertexID);
+
+	vec4 v = vec4(velocity.xyz + u_Gravity * u_DeltaTime, velocity.w);
+	vec4 p = positionLife + v * u_DeltaTime;
+
+	if (p.w <= 0.0)
+	{
+		float angle = mix(-0.35, 0.35, Random(id, 0u));
+		float speed = u_Speed * mix(0.5, 1.0, Random(id, 1u));
+		p = vec4(u_Emitter, u_Lifetime * mix(0.25, 1.0, Random(id, 2u)));
+		v = vec4(sin(angle) * speed, cos(angle) * speed, 0.0, -1.0);
+	}
+
+	o_PositionLife = p;
+	o_Velocity = v;
+}
@@ -0,0 +1,38 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 color;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+uniform mat4 u_ViewProjection;
+
+void main()
+{
+	gl_Position = u_ViewProjection * position;
+	v_TexCoord = texCoord;
+	v_Color = color;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+uniform sampler2D u_Atlas;
+
+void main()
+{
+	// The glyph edge is at 0.5 in the distance field. Smoothing over one
+	// screen pixel keeps edges crisp at any scale
+	float distance = texture(u_Atlas, v_TexCoord).r;
+	float width = fwidth(distance);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+}
@@ -0,0 +1,45 @@
+#shader vertex
+#version 330 core
+
+out vec2 v_TexCoord;
+
+void main()
+{
+	// One triangle that covers the whole screen, no vertex buffer needed
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+	v_TexCoord = position;
+	gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Scene;
+uniform sampler2D u_Bloom;
+uniform float u_BloomIntensity;
+uniform float u_Exposure;
+uniform int u_Tonemapper; // 0 none, 1 Reinhard, 2 ACES
+
+// Narkowicz's fit of the ACES filmic curve
+vec3 ACES(vec3 x)
+{
+	return clamp((x * (2.51 * x + 0.03)) / (x * (2.43 * x + 0.59) + 0.14), 0.0, 1.0);
+}
+
+void main()
+{
+	vec3 hdr = texture(u_Scene, v_TexCoord).rgb;
+	hdr += texture(u_Bloom, v_TexCoord).rgb * u_BloomIntensity;
+	hdr *= u_Exposure;
+
+	vec3 ldr = hdr;
+	if (u_Tonemapper == 1)
+		ldr = hdr / (hdr + 1.0);
+	else if (u_Tonemapper == 2)
+		ldr = ACES(hdr);
+	color = vec4(clamp(ldr, 0.0, 1.0), 1.0);
+}
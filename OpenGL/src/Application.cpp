@@ -13,6 +13,11 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "DeletionQueue.h"
+#include "GLStateCache.h"
+#include "ImGuiRenderer.h"
+#include "FrameGraph.h"
+#include "PostProcess.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
@@ -21,14 +26,23 @@
 #include "imgui/imgui_impl_glfw_gl3.h"
 
 #include "tests/TestClearColor.h"
+#include "tests/TestMultiDrawIndirect.h"
+#include "tests/TestResourceManager.h"
+#include "tests/TestParticles.h"
+#include "tests/TestText.h"
 
 //https://www.youtube.com/watch?v=A_hS4_r5KcA&list=PLlrATfBNZ98foTJPJ_Ev03o2oq3-GGOS2&index=24
 
 
-int main(void)
+int main(int argc, char** argv)
 {
     GLFWwindow* window;
 
+    // "--check" runs the non interactive checks in a hidden window and exits
+    // with their result instead of opening the test menu. CI runs it on Mesa's
+    // llvmpipe, from this directory so the res/ paths resolve
+    bool runChecks = argc > 1 && std::string(argv[1]) == "--check";
+
     /* Initialize the library */
     if (!glfwInit())
         return -1;
@@ -36,6 +50,8 @@ int main(void)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (runChecks)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     /* Create a windowed mode window and its OpenGL context */
     window = glfwCreateWindow(640, 480, "Hello World", NULL, NULL);
@@ -57,6 +73,22 @@ int main(void)
 
     std::cout << glGetString(GL_VERSION) << std::endl;
 
+    if (runChecks)
+    {
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        GLStateCache::Reset(framebufferWidth, framebufferHeight);
+
+        bool passed = test::TestMultiDrawIndirect::RunCullCheck();
+        {
+            PostProcess postProcess;
+            passed = postProcess.RunAliasingCheck(framebufferWidth, framebufferHeight) && passed;
+        }
+        DeletionQueue::Flush();
+        glfwTerminate();
+        return passed ? 0 : 1;
+    }
+
     {
         /*
         float positions[] = {
@@ -72,8 +104,11 @@ int main(void)
         };
         */
 
-        GLCall(glEnable(GL_BLEND));
-        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        GLStateCache::Reset(framebufferWidth, framebufferHeight);
+        GLStateCache::SetBlend(true);
+        GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         /*
         VertexArray va;
@@ -108,6 +143,12 @@ int main(void)
         ImGui::CreateContext();
         ImGui_ImplGlfwGL3_Init(window, true);
         ImGui::StyleColorsDark();
+        ImGuiRenderer imguiRenderer;
+
+        FrameGraph frameGraph;
+        PostProcess postProcess;
+        int graphWidth = 0, graphHeight = 0;
+        bool rebuildGraph = true;
 
         /*
         glm::vec3 translationA(200, 200, 0);
@@ -121,19 +162,57 @@ int main(void)
         test::TestMenu* testMenu = new test::TestMenu(currentTest);
         currentTest = testMenu;
         testMenu->RegisterTest<test::TestClearColor>("Clear color");
+        testMenu->RegisterTest<test::TestMultiDrawIndirect>("Multi draw indirect");
+        testMenu->RegisterTest<test::TestResourceManager>("Resource manager");
+        testMenu->RegisterTest<test::TestParticles>("Particles");
+        testMenu->RegisterTest<test::TestText>("SDF text");
+
+        double lastTime = glfwGetTime();
 
         /* Loop until the user closes the window */
         while (!glfwWindowShouldClose(window))
         {
-            /* Render here */
-            GLCall(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
-            renderer.Clear();
+            double time = glfwGetTime();
+            float deltaTime = (float)(time - lastTime);
+            lastTime = time;
+
+            // The tests render into an HDR target which post processing
+            // then resolves to the backbuffer. The graph only changes on
+            // resize or when a post processing pass is switched on or off
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            if (rebuildGraph || framebufferWidth != graphWidth || framebufferHeight != graphHeight)
+            {
+                graphWidth = framebufferWidth;
+                graphHeight = framebufferHeight;
+                rebuildGraph = false;
+
+                frameGraph.Reset();
+                if (graphWidth > 0 && graphHeight > 0)
+                {
+                    FrameGraphResource scene = frameGraph.CreateRenderTarget("Scene", { graphWidth, graphHeight, GL_RGBA16F });
+                    FrameGraphResource backbuffer = frameGraph.ImportBackbuffer("Backbuffer", graphWidth, graphHeight);
+                    frameGraph.AddPass("Scene", {}, scene, [&renderer, &currentTest]()
+                    {
+                        /* Render here */
+                        GLCall(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+                        renderer.Clear();
+                        if (currentTest)
+                            currentTest->OnRender();
+                    });
+                    postProcess.AddPasses(frameGraph, scene, backbuffer);
+                    frameGraph.Compile();
+                }
+            }
 
             ImGui_ImplGlfwGL3_NewFrame();
+            if (currentTest)
+                currentTest->OnUpdate(deltaTime);
+            // Nothing to draw into while minimised
+            if (graphWidth > 0 && graphHeight > 0)
+                frameGraph.Execute();
+
             if (currentTest)
             {
-                currentTest->OnUpdate(0.0f);
-                currentTest->OnRender();
                 ImGui::Begin("Test");
                 if (currentTest != testMenu && ImGui::Button("<-"))
                 {
@@ -144,6 +223,15 @@ int main(void)
                 ImGui::End();
             }
 
+            ImGui::Begin("Post processing");
+            rebuildGraph = postProcess.OnImGuiRender();
+            ImGui::Separator();
+            ImGui::Text("Passes: %u of %u executed", frameGraph.GetExecutedPassCount(), frameGraph.GetPassCount());
+            ImGui::Text("Render targets: %u backed by %u textures", frameGraph.GetTransientCount(), frameGraph.GetPhysicalCount());
+            ImGui::Text("Memory: %.2f MB (%.2f MB without aliasing)",
+                frameGraph.GetPhysicalBytes() / (1024.0f * 1024.0f), frameGraph.GetTransientBytes() / (1024.0f * 1024.0f));
+            ImGui::End();
+
             /*
             {
                 glm::mat4 model = glm::translate(glm::mat4(1.0f), translationA);
@@ -179,10 +267,12 @@ int main(void)
             */
 
             ImGui::Render();
-            ImGui_ImplGlfwGL3_RenderDrawData(ImGui::GetDrawData());
+            imguiRenderer.Render(ImGui::GetDrawData());
 
             /* Swap front and back buffers */
             GLCall(glfwSwapBuffers(window));
+            // Deletes GL objects released in earlier frames the GPU has finished with
+            DeletionQueue::EndFrame();
             /* Poll for and process events */
             GLCall(glfwPollEvents());
         }
@@ -191,6 +281,9 @@ int main(void)
             delete testMenu;
     }
 
+    // Nothing can be in use once the context is going away
+    DeletionQueue::Flush();
+
     ImGui_ImplGlfwGL3_Shutdown();
     ImGui::DestroyContext();
     glfwTerminate();
@@ -0,0 +1,76 @@
+#include "DeletionQueue.h"
+#include "Renderer.h"
+
+std::vector<DeletionQueue::PendingObject> DeletionQueue::s_Current;
+std::vector<DeletionQueue::FrameBatch> DeletionQueue::s_InFlight;
+
+void DeletionQueue::Enqueue(GLObjectType type, unsigned int id)
+{
+	if (id == 0)
+		return;
+
+	s_Current.push_back({ type, id });
+}
+
+void DeletionQueue::EndFrame()
+{
+	if (!s_Current.empty())
+	{
+		FrameBatch batch;
+		GLCall(batch.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		batch.Objects.swap(s_Current);
+		s_InFlight.push_back(std::move(batch));
+	}
+
+	// Fences signal in submission order, so stop at the first one that hasn't
+	unsigned int completed = 0;
+	for (auto& batch : s_InFlight)
+	{
+		GLsync fence = (GLsync)batch.Fence;
+		// A timeout of 0 only polls the fence
+		GLCall(GLenum status = glClientWaitSync(fence, 0, 0));
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			break;
+
+		Delete(batch.Objects);
+		GLCall(glDeleteSync(fence));
+		completed++;
+	}
+	s_InFlight.erase(s_InFlight.begin(), s_InFlight.begin() + completed);
+}
+
+void DeletionQueue::Flush()
+{
+	for (auto& batch : s_InFlight)
+	{
+		Delete(batch.Objects);
+		GLCall(glDeleteSync((GLsync)batch.Fence));
+	}
+	s_InFlight.clear();
+
+	Delete(s_Current);
+	s_Current.clear();
+}
+
+unsigned int DeletionQueue::GetPendingCount()
+{
+	size_t count = s_Current.size();
+	for (const auto& batch : s_InFlight)
+		count += batch.Objects.size();
+	return (unsigned int)count;
+}
+
+void DeletionQueue::Delete(const std::vector<PendingObject>& objects)
+{
+	for (const auto& object : objects)
+	{
+		switch (object.Type)
+		{
+			case GLObjectType::Buffer:      GLCall(glDeleteBuffers(1, &object.ID)); break;
+			case GLObjectType::VertexArray: GLCall(glDeleteVertexArrays(1, &object.ID)); break;
+			case GLObjectType::Texture:     GLCall(glDeleteTextures(1, &object.ID)); break;
+			case GLObjectType::Program:     GLCall(glDeleteProgram(object.ID)); break;
+			case GLObjectType::Framebuffer: GLCall(glDeleteFramebuffers(1, &object.ID)); break;
+		}
+	}
+}
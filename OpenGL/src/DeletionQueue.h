@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+
+enum class GLObjectType
+{
+	Buffer,
+	VertexArray,
+	Texture,
+	Program,
+	Framebuffer,
+};
+
+// GL objects are handed here instead of being deleted straight away. Each
+// frame's deletions are tagged with a fence at EndFrame and only deleted
+// once the GPU has passed that fence, so destroying something the GPU may
+// still be reading never forces the driver to stall.
+//
+// The GL wrappers that enqueue from their destructors are move only, since a
+// copy would enqueue the same object twice. Moving leaves id 0 behind, which
+// Enqueue ignores. Move assignment enqueues the object being replaced and
+// Enqueue can throw std::bad_alloc, so only the move constructors are noexcept.
+class DeletionQueue
+{
+private:
+	struct PendingObject
+	{
+		GLObjectType Type;
+		unsigned int ID;
+	};
+
+	struct FrameBatch
+	{
+		void* Fence; // GLsync
+		std::vector<PendingObject> Objects;
+	};
+
+	static std::vector<PendingObject> s_Current;
+	static std::vector<FrameBatch> s_InFlight;
+
+public:
+	// Does nothing for id 0, so moved from objects can call it unconditionally
+	static void Enqueue(GLObjectType type, unsigned int id);
+
+	// Call once per frame after submitting all work (after SwapBuffers).
+	// Fences this frame's deletions and deletes any whose fence has signalled
+	static void EndFrame();
+
+	// Deletes everything immediately. Call before destroying the context
+	static void Flush();
+
+	static unsigned int GetPendingCount();
+
+private:
+	static void Delete(const std::vector<PendingObject>& objects);
+};
@@ -0,0 +1,114 @@
+#include "Font.h"
+#include "Renderer.h"
+#include "stb_truetype/stb_truetype.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const int ATLAS_WIDTH = 512;
+
+Font::Font(const std::string& path, float bakeSize, int padding, int firstCodepoint, int lastCodepoint)
+	: m_Info(std::make_unique<stbtt_fontinfo>())
+	, m_Scale(0.0f)
+	, m_LineHeight(0.0f)
+{
+	std::ifstream stream(path, std::ios::binary);
+	m_FileData.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	if (m_FileData.empty() || !stbtt_InitFont(m_Info.get(), m_FileData.data(), stbtt_GetFontOffsetForIndex(m_FileData.data(), 0)))
+	{
+		std::cout << "Failed to load font '" << path << "'" << std::endl;
+		return;
+	}
+
+	m_Scale = stbtt_ScaleForPixelHeight(m_Info.get(), bakeSize);
+	int ascent, descent, lineGap;
+	stbtt_GetFontVMetrics(m_Info.get(), &ascent, &descent, &lineGap);
+	m_LineHeight = (ascent - descent + lineGap) * m_Scale;
+
+	// The edge sits at 128 and the field fades to 0 over padding pixels
+	const unsigned char onEdge = 128;
+	const float distanceScale = (float)onEdge / padding;
+
+	struct Bitmap
+	{
+		int Codepoint;
+		unsigned char* Pixels;
+		int Width, Height, X, Y;
+	};
+	std::vector<Bitmap> bitmaps;
+
+	// Shelf packing, glyphs go left to right and start a new row when full
+	int x = 0, y = 0, rowHeight = 0;
+	for (int codepoint = firstCodepoint; codepoint <= lastCodepoint; codepoint++)
+	{
+		int advance, leftSideBearing;
+		stbtt_GetCodepointHMetrics(m_Info.get(), codepoint, &advance, &leftSideBearing);
+
+		Bitmap bitmap = { codepoint, nullptr, 0, 0, 0, 0 };
+		int xoff = 0, yoff = 0;
+		bitmap.Pixels = stbtt_GetCodepointSDF(m_Info.get(), m_Scale, codepoint, padding, onEdge, distanceScale,
+			&bitmap.Width, &bitmap.Height, &xoff, &yoff);
+
+		// Whitespace has no bitmap but still needs its advance
+		Glyph glyph = {};
+		glyph.Advance = advance * m_Scale;
+
+		if (bitmap.Pixels)
+		{
+			if (x + bitmap.Width > ATLAS_WIDTH)
+			{
+				x = 0;
+				y += rowHeight + 1;
+				rowHeight = 0;
+			}
+			bitmap.X = x;
+			bitmap.Y = y;
+			x += bitmap.Width + 1;
+			rowHeight = glm::max(rowHeight, bitmap.Height);
+			bitmaps.push_back(bitmap);
+
+			glyph.Offset = glm::vec2((float)xoff, (float)-yoff);
+			glyph.Size = glm::vec2((float)bitmap.Width, (float)bitmap.Height);
+			// UVs are filled in once the atlas height is known
+			glyph.UV0 = glm::vec2((float)bitmap.X, (float)bitmap.Y);
+			glyph.UV1 = glyph.UV0 + glyph.Size;
+		}
+		m_Glyphs[codepoint] = glyph;
+	}
+
+	int atlasHeight = 1;
+	while (atlasHeight < y + rowHeight)
+		atlasHeight *= 2;
+
+	std::vector<unsigned char> pixels(ATLAS_WIDTH * atlasHeight, 0);
+	for (const auto& bitmap : bitmaps)
+	{
+		for (int row = 0; row < bitmap.Height; row++)
+			memcpy(&pixels[(bitmap.Y + row) * ATLAS_WIDTH + bitmap.X], &bitmap.Pixels[row * bitmap.Width], bitmap.Width);
+		stbtt_FreeSDF(bitmap.Pixels, nullptr);
+	}
+
+	glm::vec2 atlasSize((float)ATLAS_WIDTH, (float)atlasHeight);
+	for (auto& glyph : m_Glyphs)
+	{
+		glyph.second.UV0 /= atlasSize;
+		glyph.second.UV1 /= atlasSize;
+	}
+
+	m_Atlas = std::make_unique<Texture>(ATLAS_WIDTH, atlasHeight, 1, pixels.data());
+}
+
+Font::~Font()
+{
+}
+
+const Glyph* Font::GetGlyph(int codepoint) const
+{
+	auto it = m_Glyphs.find(codepoint);
+	return it != m_Glyphs.end() ? &it->second : nullptr;
+}
+
+float Font::GetKerning(int first, int second) const
+{
+	return stbtt_GetCodepointKernAdvance(m_Info.get(), first, second) * m_Scale;
+}
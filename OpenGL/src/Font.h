@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "glm/glm.hpp"
+
+#include "Texture.h"
+
+struct stbtt_fontinfo;
+
+// Metrics are in pixels at the font's bake size, y up from the baseline
+struct Glyph
+{
+	glm::vec2 UV0, UV1;   // top left and bottom right in the atlas
+	glm::vec2 Offset;     // top left corner of the quad relative to the pen
+	glm::vec2 Size;
+	float Advance;
+};
+
+// A TrueType font whose glyphs are rasterized once, as signed distance
+// fields, into a single channel atlas. Because the atlas stores distances
+// rather than coverage, one bake size renders sharply at any scale.
+class Font
+{
+private:
+	std::vector<unsigned char> m_FileData; // stb_truetype reads from it for kerning
+	std::unique_ptr<stbtt_fontinfo> m_Info;
+	std::unordered_map<int, Glyph> m_Glyphs;
+	std::unique_ptr<Texture> m_Atlas;
+	float m_Scale;
+	float m_LineHeight;
+
+public:
+	// Bakes codepoints [firstCodepoint, lastCodepoint]. padding is the
+	// distance in pixels the field spreads out from each glyph's edge
+	Font(const std::string& path, float bakeSize = 48.0f, int padding = 6, int firstCodepoint = 32, int lastCodepoint = 126);
+	~Font();
+
+	Font(const Font&) = delete;
+	Font& operator=(const Font&) = delete;
+
+	inline bool IsLoaded() const { return m_Atlas != nullptr; }
+
+	// nullptr for codepoints that weren't baked
+	const Glyph* GetGlyph(int codepoint) const;
+	float GetKerning(int first, int second) const;
+
+	inline float GetLineHeight() const { return m_LineHeight; }
+	inline const Texture& GetAtlas() const { return *m_Atlas; }
+};
@@ -0,0 +1,260 @@
+#include "FrameGraph.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include <algorithm>
+
+FrameGraph::FrameGraph()
+	: m_Compiled(false)
+{
+}
+
+FrameGraph::~FrameGraph()
+{
+}
+
+void FrameGraph::Reset()
+{
+	m_Resources.clear();
+	m_Passes.clear();
+	m_Order.clear();
+	m_Compiled = false;
+}
+
+FrameGraphResource FrameGraph::CreateRenderTarget(const std::string& name, const RenderTargetDesc& desc)
+{
+	m_Resources.push_back({ name, desc, false, -1, 0, -1, -1, -1 });
+	m_Compiled = false;
+	return (FrameGraphResource)m_Resources.size() - 1;
+}
+
+FrameGraphResource FrameGraph::ImportBackbuffer(const std::string& name, int width, int height)
+{
+	m_Resources.push_back({ name, { width, height, GL_RGBA8 }, true, -1, 0, -1, -1, -1 });
+	m_Compiled = false;
+	return (FrameGraphResource)m_Resources.size() - 1;
+}
+
+void FrameGraph::AddPass(const std::string& name, const std::vector<FrameGraphResource>& inputs, FrameGraphResource output, const ExecuteFunction& execute)
+{
+	// Each resource has exactly one writer, which keeps ordering unambiguous
+	ASSERT(m_Resources[output].Producer == -1);
+	m_Resources[output].Producer = (int)m_Passes.size();
+	m_Passes.push_back({ name, inputs, output, execute, 0, false });
+	m_Compiled = false;
+}
+
+void FrameGraph::Compile()
+{
+	// Cull: a pass is needed if its output is imported or read by a needed
+	// pass. Walk back from resources nobody reads, dropping their writers
+	for (auto& resource : m_Resources)
+		resource.RefCount = 0;
+	for (auto& pass : m_Passes)
+	{
+		pass.RefCount = 1;
+		pass.Culled = false;
+		for (FrameGraphResource input : pass.Inputs)
+			m_Resources[input].RefCount++;
+	}
+
+	std::vector<FrameGraphResource> unused;
+	for (unsigned int i = 0; i < m_Resources.size(); i++)
+	{
+		if (m_Resources[i].RefCount == 0 && !m_Resources[i].Imported)
+			unused.push_back(i);
+	}
+	while (!unused.empty())
+	{
+		const Resource& resource = m_Resources[unused.back()];
+		unused.pop_back();
+		if (resource.Producer < 0)
+			continue;
+
+		Pass& producer = m_Passes[resource.Producer];
+		if (--producer.RefCount > 0)
+			continue;
+
+		producer.Culled = true;
+		for (FrameGraphResource input : producer.Inputs)
+		{
+			if (--m_Resources[input].RefCount == 0 && !m_Resources[input].Imported)
+				unused.push_back(input);
+		}
+	}
+
+	// Order: Kahn's algorithm over the live passes, picking the earliest
+	// added ready pass each time so independent passes keep their order
+	std::vector<unsigned int> pendingInputs(m_Passes.size(), 0);
+	for (unsigned int i = 0; i < m_Passes.size(); i++)
+	{
+		for (FrameGraphResource input : m_Passes[i].Inputs)
+		{
+			int producer = m_Resources[input].Producer;
+			ASSERT(producer >= 0); // read before anything writes it
+			if (producer >= 0 && !m_Passes[producer].Culled)
+				pendingInputs[i]++;
+		}
+	}
+
+	m_Order.clear();
+	std::vector<bool> scheduled(m_Passes.size(), false);
+	bool progress = true;
+	while (progress)
+	{
+		progress = false;
+		for (unsigned int i = 0; i < m_Passes.size(); i++)
+		{
+			if (m_Passes[i].Culled || scheduled[i] || pendingInputs[i] > 0)
+				continue;
+
+			scheduled[i] = true;
+			m_Order.push_back(i);
+			for (unsigned int j = 0; j < m_Passes.size(); j++)
+			{
+				for (FrameGraphResource input : m_Passes[j].Inputs)
+				{
+					if (m_Resources[input].Producer == (int)i)
+						pendingInputs[j]--;
+				}
+			}
+			progress = true;
+			break;
+		}
+	}
+
+	// Anything left unscheduled is part of a cycle
+	unsigned int livePasses = 0;
+	for (const auto& pass : m_Passes)
+		livePasses += pass.Culled ? 0 : 1;
+	ASSERT(m_Order.size() == livePasses);
+
+	// Lifetimes in execution order
+	for (auto& resource : m_Resources)
+	{
+		resource.FirstUse = -1;
+		resource.LastUse = -1;
+		resource.Physical = -1;
+	}
+	for (unsigned int order = 0; order < m_Order.size(); order++)
+	{
+		const Pass& pass = m_Passes[m_Order[order]];
+		m_Resources[pass.Output].FirstUse = order;
+		m_Resources[pass.Output].LastUse = std::max(m_Resources[pass.Output].LastUse, (int)order);
+		for (FrameGraphResource input : pass.Inputs)
+			m_Resources[input].LastUse = std::max(m_Resources[input].LastUse, (int)order);
+	}
+
+	// Alias: hand each transient target a free physical texture with the
+	// same desc. A texture is free once the pass that last reads it is
+	// strictly behind, so a pass never reads and writes the same texture
+	std::vector<int> busyUntil(m_Physical.size(), -1);
+	std::vector<bool> used(m_Physical.size(), false);
+	for (unsigned int order = 0; order < m_Order.size(); order++)
+	{
+		Resource& resource = m_Resources[m_Passes[m_Order[order]].Output];
+		if (resource.Imported)
+			continue;
+
+		for (unsigned int i = 0; i < m_Physical.size(); i++)
+		{
+			const RenderTarget& target = m_Physical[i];
+			RenderTargetDesc desc = { target.GetWidth(), target.GetHeight(), target.GetFormat() };
+			if (busyUntil[i] < (int)order && desc == resource.Desc)
+			{
+				resource.Physical = i;
+				break;
+			}
+		}
+		if (resource.Physical < 0)
+		{
+			resource.Physical = (int)m_Physical.size();
+			m_Physical.emplace_back(resource.Desc.Width, resource.Desc.Height, resource.Desc.Format);
+			busyUntil.push_back(-1);
+			used.push_back(false);
+		}
+		busyUntil[resource.Physical] = resource.LastUse;
+		used[resource.Physical] = true;
+	}
+
+	// Drop textures left over from an earlier compile, renumbering the rest
+	std::vector<int> remap(m_Physical.size(), -1);
+	std::vector<RenderTarget> kept;
+	for (unsigned int i = 0; i < m_Physical.size(); i++)
+	{
+		if (!used[i])
+			continue;
+		remap[i] = (int)kept.size();
+		kept.push_back(std::move(m_Physical[i]));
+	}
+	m_Physical = std::move(kept);
+	for (auto& resource : m_Resources)
+	{
+		if (resource.Physical >= 0)
+			resource.Physical = remap[resource.Physical];
+	}
+
+	m_Compiled = true;
+}
+
+void FrameGraph::Execute()
+{
+	if (!m_Compiled)
+		Compile();
+
+	GLStateCache::State previous = GLStateCache::Get();
+	for (unsigned int index : m_Order)
+	{
+		const Pass& pass = m_Passes[index];
+		const Resource& output = m_Resources[pass.Output];
+
+		for (unsigned int slot = 0; slot < pass.Inputs.size(); slot++)
+		{
+			const Resource& input = m_Resources[pass.Inputs[slot]];
+			ASSERT(!input.Imported); // the backbuffer can't be sampled
+			m_Physical[input.Physical].BindTexture(slot);
+		}
+
+		if (output.Imported)
+		{
+			GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		}
+		else
+		{
+			m_Physical[output.Physical].Bind();
+		}
+		GLStateCache::SetViewport(0, 0, output.Desc.Width, output.Desc.Height);
+
+		pass.Execute();
+	}
+
+	GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+	GLCall(glActiveTexture(GL_TEXTURE0));
+	GLStateCache::Apply(previous);
+}
+
+unsigned int FrameGraph::GetTransientCount() const
+{
+	unsigned int count = 0;
+	for (const auto& resource : m_Resources)
+		count += resource.Physical >= 0 ? 1 : 0;
+	return count;
+}
+
+unsigned int FrameGraph::GetTransientBytes() const
+{
+	unsigned int bytes = 0;
+	for (const auto& resource : m_Resources)
+	{
+		if (resource.Physical >= 0)
+			bytes += m_Physical[resource.Physical].GetSizeInBytes();
+	}
+	return bytes;
+}
+
+unsigned int FrameGraph::GetPhysicalBytes() const
+{
+	unsigned int bytes = 0;
+	for (const auto& target : m_Physical)
+		bytes += target.GetSizeInBytes();
+	return bytes;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "RenderTarget.h"
+
+typedef unsigned int FrameGraphResource;
+
+struct RenderTargetDesc
+{
+	int Width;
+	int Height;
+	unsigned int Format; // e.g. GL_RGBA8, GL_RGBA16F
+
+	inline bool operator==(const RenderTargetDesc& other) const { return Width == other.Width && Height == other.Height && Format == other.Format; }
+};
+
+// A small render graph. Passes declare the render targets they read and
+// the one they write, and Compile then
+//  - culls passes whose output never reaches an imported target,
+//  - orders the rest so every input is written before it is read,
+//  - backs transient targets with as few textures as possible by letting
+//    targets with the same desc and non overlapping lifetimes share one.
+// The physical textures are kept between compiles, so rebuilding the
+// graph (e.g. on resize) only allocates what changed.
+class FrameGraph
+{
+public:
+	// Inputs are bound to texture slots in the order they were declared and
+	// the output is bound as the framebuffer, with a matching viewport
+	typedef std::function<void()> ExecuteFunction;
+
+private:
+	struct Resource
+	{
+		std::string Name;
+		RenderTargetDesc Desc;
+		bool Imported;           // backbuffer, never culled or aliased
+		int Producer;
+		unsigned int RefCount;
+		int FirstUse, LastUse;   // in execution order
+		int Physical;
+	};
+
+	struct Pass
+	{
+		std::string Name;
+		std::vector<FrameGraphResource> Inputs;
+		FrameGraphResource Output;
+		ExecuteFunction Execute;
+		unsigned int RefCount;
+		bool Culled;
+	};
+
+	std::vector<Resource> m_Resources;
+	std::vector<Pass> m_Passes;
+	std::vector<unsigned int> m_Order;
+	std::vector<RenderTarget> m_Physical;
+	bool m_Compiled;
+
+public:
+	FrameGraph();
+	~FrameGraph();
+
+	// Removes all passes and resources, keeping the physical textures for the next Compile
+	void Reset();
+
+	FrameGraphResource CreateRenderTarget(const std::string& name, const RenderTargetDesc& desc);
+	FrameGraphResource ImportBackbuffer(const std::string& name, int width, int height);
+	void AddPass(const std::string& name, const std::vector<FrameGraphResource>& inputs, FrameGraphResource output, const ExecuteFunction& execute);
+
+	void Compile();
+	void Execute();
+
+	inline const RenderTargetDesc& GetDesc(FrameGraphResource resource) const { return m_Resources[resource].Desc; }
+
+	inline unsigned int GetPassCount() const { return (unsigned int)m_Passes.size(); }
+	inline unsigned int GetExecutedPassCount() const { return (unsigned int)m_Order.size(); }
+	unsigned int GetTransientCount() const;
+	inline unsigned int GetPhysicalCount() const { return (unsigned int)m_Physical.size(); }
+	// Memory the transient targets would need without aliasing
+	unsigned int GetTransientBytes() const;
+	unsigned int GetPhysicalBytes() const;
+};
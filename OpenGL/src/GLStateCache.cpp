@@ -0,0 +1,136 @@
+#include "GLStateCache.h"
+#include "Renderer.h"
+
+GLStateCache::State GLStateCache::s_State;
+
+static void SetCapability(GLenum capability, bool& current, bool enabled)
+{
+	if (current == enabled)
+		return;
+
+	// GLCall expands to several statements, so keep the braces
+	if (enabled)
+	{
+		GLCall(glEnable(capability));
+	}
+	else
+	{
+		GLCall(glDisable(capability));
+	}
+	current = enabled;
+}
+
+void GLStateCache::Reset(int viewportWidth, int viewportHeight)
+{
+	GLCall(glDisable(GL_BLEND));
+	GLCall(glBlendFunc(GL_ONE, GL_ZERO));
+	GLCall(glBlendEquation(GL_FUNC_ADD));
+	GLCall(glDisable(GL_CULL_FACE));
+	GLCall(glDisable(GL_DEPTH_TEST));
+	GLCall(glDisable(GL_SCISSOR_TEST));
+	GLCall(glScissor(0, 0, viewportWidth, viewportHeight));
+	GLCall(glViewport(0, 0, viewportWidth, viewportHeight));
+	GLCall(glPolygonMode(GL_FRONT_AND_BACK, GL_FILL));
+	GLCall(glDisable(GL_RASTERIZER_DISCARD));
+
+	s_State.Blend = false;
+	s_State.BlendSrc = GL_ONE;
+	s_State.BlendDst = GL_ZERO;
+	s_State.BlendEquation = GL_FUNC_ADD;
+	s_State.CullFace = false;
+	s_State.DepthTest = false;
+	s_State.ScissorTest = false;
+	s_State.Scissor[0] = s_State.Viewport[0] = 0;
+	s_State.Scissor[1] = s_State.Viewport[1] = 0;
+	s_State.Scissor[2] = s_State.Viewport[2] = viewportWidth;
+	s_State.Scissor[3] = s_State.Viewport[3] = viewportHeight;
+	s_State.PolygonMode = GL_FILL;
+	s_State.RasterizerDiscard = false;
+}
+
+void GLStateCache::SetBlend(bool enabled)
+{
+	SetCapability(GL_BLEND, s_State.Blend, enabled);
+}
+
+void GLStateCache::SetBlendFunc(unsigned int src, unsigned int dst)
+{
+	if (s_State.BlendSrc == src && s_State.BlendDst == dst)
+		return;
+
+	GLCall(glBlendFunc(src, dst));
+	s_State.BlendSrc = src;
+	s_State.BlendDst = dst;
+}
+
+void GLStateCache::SetBlendEquation(unsigned int mode)
+{
+	if (s_State.BlendEquation == mode)
+		return;
+
+	GLCall(glBlendEquation(mode));
+	s_State.BlendEquation = mode;
+}
+
+void GLStateCache::SetCullFace(bool enabled)
+{
+	SetCapability(GL_CULL_FACE, s_State.CullFace, enabled);
+}
+
+void GLStateCache::SetDepthTest(bool enabled)
+{
+	SetCapability(GL_DEPTH_TEST, s_State.DepthTest, enabled);
+}
+
+void GLStateCache::SetScissorTest(bool enabled)
+{
+	SetCapability(GL_SCISSOR_TEST, s_State.ScissorTest, enabled);
+}
+
+void GLStateCache::SetScissor(int x, int y, int width, int height)
+{
+	int* box = s_State.Scissor;
+	if (box[0] == x && box[1] == y && box[2] == width && box[3] == height)
+		return;
+
+	GLCall(glScissor(x, y, width, height));
+	box[0] = x; box[1] = y; box[2] = width; box[3] = height;
+}
+
+void GLStateCache::SetViewport(int x, int y, int width, int height)
+{
+	int* box = s_State.Viewport;
+	if (box[0] == x && box[1] == y && box[2] == width && box[3] == height)
+		return;
+
+	GLCall(glViewport(x, y, width, height));
+	box[0] = x; box[1] = y; box[2] = width; box[3] = height;
+}
+
+void GLStateCache::SetPolygonMode(unsigned int mode)
+{
+	if (s_State.PolygonMode == mode)
+		return;
+
+	GLCall(glPolygonMode(GL_FRONT_AND_BACK, mode));
+	s_State.PolygonMode = mode;
+}
+
+void GLStateCache::SetRasterizerDiscard(bool enabled)
+{
+	SetCapability(GL_RASTERIZER_DISCARD, s_State.RasterizerDiscard, enabled);
+}
+
+void GLStateCache::Apply(const State& state)
+{
+	SetBlend(state.Blend);
+	SetBlendFunc(state.BlendSrc, state.BlendDst);
+	SetBlendEquation(state.BlendEquation);
+	SetCullFace(state.CullFace);
+	SetDepthTest(state.DepthTest);
+	SetScissorTest(state.ScissorTest);
+	SetScissor(state.Scissor[0], state.Scissor[1], state.Scissor[2], state.Scissor[3]);
+	SetViewport(state.Viewport[0], state.Viewport[1], state.Viewport[2], state.Viewport[3]);
+	SetPolygonMode(state.PolygonMode);
+	SetRasterizerDiscard(state.RasterizerDiscard);
+}
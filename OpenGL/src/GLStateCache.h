@@ -0,0 +1,46 @@
+#pragma once
+
+// Shadow copy of the fixed function state the renderers touch. Setters only
+// reach GL when the value actually changes, and since the cache always knows
+// the current value nothing needs a glGet* round trip to save and restore
+// state. Everything that changes this state must go through here.
+class GLStateCache
+{
+public:
+	struct State
+	{
+		bool Blend;
+		unsigned int BlendSrc, BlendDst;
+		unsigned int BlendEquation;
+		bool CullFace;
+		bool DepthTest;
+		bool ScissorTest;
+		int Scissor[4];
+		int Viewport[4];
+		unsigned int PolygonMode;
+		bool RasterizerDiscard;
+	};
+
+private:
+	static State s_State;
+
+public:
+	// Pushes the GL defaults (with the given viewport) to GL and the cache.
+	// Call once after the context is created
+	static void Reset(int viewportWidth, int viewportHeight);
+
+	static void SetBlend(bool enabled);
+	static void SetBlendFunc(unsigned int src, unsigned int dst);
+	static void SetBlendEquation(unsigned int mode);
+	static void SetCullFace(bool enabled);
+	static void SetDepthTest(bool enabled);
+	static void SetScissorTest(bool enabled);
+	static void SetScissor(int x, int y, int width, int height);
+	static void SetViewport(int x, int y, int width, int height);
+	static void SetPolygonMode(unsigned int mode);
+	static void SetRasterizerDiscard(bool enabled);
+
+	inline static const State& Get() { return s_State; }
+	// Restores a state returned by Get, only touching what differs
+	static void Apply(const State& state);
+};
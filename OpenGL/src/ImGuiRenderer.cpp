@@ -0,0 +1,169 @@
+#include "ImGuiRenderer.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "imgui/imgui.h"
+#include "glm/gtc/matrix_transform.hpp"
+#include <cstring>
+
+// Starting size of each ring region, grows when a frame needs more
+static const unsigned int INITIAL_VERTEX_COUNT = 64 * 1024;
+static const unsigned int INITIAL_INDEX_COUNT = 128 * 1024;
+
+ImGuiRenderer::ImGuiRenderer()
+	: m_Shader("res/shaders/ImGui.shader")
+	, m_VertexBuffer(GL_ARRAY_BUFFER, INITIAL_VERTEX_COUNT * sizeof(ImDrawVert))
+	, m_IndexBuffer(GL_ELEMENT_ARRAY_BUFFER, INITIAL_INDEX_COUNT * sizeof(ImDrawIdx))
+	, m_AttribBuffer(0)
+	, m_AttribOffset(0)
+{
+	m_VertexArray.Bind();
+	GLCall(glEnableVertexAttribArray(0));
+	GLCall(glEnableVertexAttribArray(1));
+	GLCall(glEnableVertexAttribArray(2));
+	m_VertexArray.Unbind();
+}
+
+ImGuiRenderer::~ImGuiRenderer()
+{
+}
+
+// Index of the first draw list that differs from the last upload, or
+// CmdListsCount when nothing changed. memcmp stops at the first difference,
+// so a changed frame usually only compares part of the data
+int ImGuiRenderer::FindFirstChangedList(const ImDrawData* drawData) const
+{
+	if (drawData->TotalVtxCount * sizeof(ImDrawVert) != m_LastVertices.size() ||
+		drawData->TotalIdxCount * sizeof(ImDrawIdx) != m_LastIndices.size())
+		return 0;
+
+	size_t vertexOffset = 0;
+	size_t indexOffset = 0;
+	for (int n = 0; n < drawData->CmdListsCount; n++)
+	{
+		const ImDrawList* cmdList = drawData->CmdLists[n];
+		size_t vertexBytes = cmdList->VtxBuffer.Size * sizeof(ImDrawVert);
+		size_t indexBytes = cmdList->IdxBuffer.Size * sizeof(ImDrawIdx);
+		if ((vertexBytes > 0 && memcmp(m_LastVertices.data() + vertexOffset, cmdList->VtxBuffer.Data, vertexBytes) != 0) ||
+			(indexBytes > 0 && memcmp(m_LastIndices.data() + indexOffset, cmdList->IdxBuffer.Data, indexBytes) != 0))
+			return n;
+		vertexOffset += vertexBytes;
+		indexOffset += indexBytes;
+	}
+	return drawData->CmdListsCount;
+}
+
+// Lists before firstChangedList already match the copy kept for comparing,
+// so only the rest of it is refreshed
+void ImGuiRenderer::Upload(ImDrawData* drawData, int firstChangedList)
+{
+	m_LastVertices.resize(drawData->TotalVtxCount * sizeof(ImDrawVert));
+	m_LastIndices.resize(drawData->TotalIdxCount * sizeof(ImDrawIdx));
+
+	// The vertex array is bound, so mapping the index buffer attaches it there
+	unsigned char* vertices = (unsigned char*)m_VertexBuffer.Map((unsigned int)m_LastVertices.size());
+	unsigned char* indices = (unsigned char*)m_IndexBuffer.Map((unsigned int)m_LastIndices.size());
+	size_t vertexOffset = 0;
+	size_t indexOffset = 0;
+	for (int n = 0; n < drawData->CmdListsCount; n++)
+	{
+		const ImDrawList* cmdList = drawData->CmdLists[n];
+		size_t vertexBytes = cmdList->VtxBuffer.Size * sizeof(ImDrawVert);
+		size_t indexBytes = cmdList->IdxBuffer.Size * sizeof(ImDrawIdx);
+		memcpy(vertices + vertexOffset, cmdList->VtxBuffer.Data, vertexBytes);
+		memcpy(indices + indexOffset, cmdList->IdxBuffer.Data, indexBytes);
+		if (n >= firstChangedList)
+		{
+			memcpy(m_LastVertices.data() + vertexOffset, cmdList->VtxBuffer.Data, vertexBytes);
+			memcpy(m_LastIndices.data() + indexOffset, cmdList->IdxBuffer.Data, indexBytes);
+		}
+		vertexOffset += vertexBytes;
+		indexOffset += indexBytes;
+	}
+	m_VertexBuffer.Unmap();
+	m_IndexBuffer.Unmap();
+	// May have been reallocated by Map
+	m_IndexBuffer.Bind();
+
+	// Point the attributes at this frame's region
+	if (m_AttribBuffer != m_VertexBuffer.GetRendererID() || m_AttribOffset != m_VertexBuffer.GetOffset())
+	{
+		m_AttribBuffer = m_VertexBuffer.GetRendererID();
+		m_AttribOffset = m_VertexBuffer.GetOffset();
+
+		m_VertexBuffer.Bind();
+		GLCall(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (const void*)(m_AttribOffset + IM_OFFSETOF(ImDrawVert, pos))));
+		GLCall(glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (const void*)(m_AttribOffset + IM_OFFSETOF(ImDrawVert, uv))));
+		GLCall(glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (const void*)(m_AttribOffset + IM_OFFSETOF(ImDrawVert, col))));
+	}
+}
+
+void ImGuiRenderer::Render(ImDrawData* drawData)
+{
+	// Avoid rendering when minimized, scale coordinates for retina displays
+	ImGuiIO& io = ImGui::GetIO();
+	int fbWidth = (int)(io.DisplaySize.x * io.DisplayFramebufferScale.x);
+	int fbHeight = (int)(io.DisplaySize.y * io.DisplayFramebufferScale.y);
+	if (fbWidth == 0 || fbHeight == 0 || drawData->TotalVtxCount == 0)
+		return;
+	drawData->ScaleClipRects(io.DisplayFramebufferScale);
+
+	m_VertexArray.Bind();
+
+	// Nothing to compare against on the first frame, the sizes won't match
+	int firstChangedList = FindFirstChangedList(drawData);
+	if (firstChangedList < drawData->CmdListsCount)
+		Upload(drawData, firstChangedList);
+
+	// Alpha blending, no face culling, no depth testing, scissor enabled, polygon fill
+	GLStateCache::State previous = GLStateCache::Get();
+	GLStateCache::SetBlend(true);
+	GLStateCache::SetBlendEquation(GL_FUNC_ADD);
+	GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLStateCache::SetCullFace(false);
+	GLStateCache::SetDepthTest(false);
+	GLStateCache::SetScissorTest(true);
+	GLStateCache::SetPolygonMode(GL_FILL);
+	GLStateCache::SetViewport(0, 0, fbWidth, fbHeight);
+
+	glm::mat4 projection = glm::ortho(0.0f, io.DisplaySize.x, io.DisplaySize.y, 0.0f, -1.0f, 1.0f);
+	m_Shader.Bind();
+	m_Shader.SetUniform1i("u_Texture", 0);
+	m_Shader.SetUniformMat4f("u_Projection", projection);
+	GLCall(glActiveTexture(GL_TEXTURE0));
+
+	// Lists were uploaded back to back, so each one is drawn with its
+	// vertex offset as the base vertex
+	const GLenum indexType = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	size_t indexOffset = m_IndexBuffer.GetOffset();
+	int baseVertex = 0;
+	for (int n = 0; n < drawData->CmdListsCount; n++)
+	{
+		const ImDrawList* cmdList = drawData->CmdLists[n];
+		for (int i = 0; i < cmdList->CmdBuffer.Size; i++)
+		{
+			const ImDrawCmd* cmd = &cmdList->CmdBuffer[i];
+			if (cmd->UserCallback)
+			{
+				cmd->UserCallback(cmdList, cmd);
+			}
+			else
+			{
+				GLCall(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)cmd->TextureId));
+				GLStateCache::SetScissor((int)cmd->ClipRect.x, (int)(fbHeight - cmd->ClipRect.w),
+					(int)(cmd->ClipRect.z - cmd->ClipRect.x), (int)(cmd->ClipRect.w - cmd->ClipRect.y));
+				GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)cmd->ElemCount, indexType, (const void*)indexOffset, baseVertex));
+			}
+			indexOffset += cmd->ElemCount * sizeof(ImDrawIdx);
+		}
+		baseVertex += cmdList->VtxBuffer.Size;
+	}
+
+	m_VertexBuffer.Fence();
+	m_IndexBuffer.Fence();
+
+	GLStateCache::Apply(previous);
+	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	m_Shader.Unbind();
+	// Keeps later index buffer binds from landing in this vertex array
+	m_VertexArray.Unbind();
+}
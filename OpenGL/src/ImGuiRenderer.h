@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include "VertexArray.h"
+#include "Shader.h"
+#include "StreamBuffer.h"
+
+struct ImDrawData;
+
+// Replacement for ImGui_ImplGlfwGL3_RenderDrawData. The platform side
+// (input, font texture) still comes from imgui_impl_glfw_gl3.
+// Vertices and indices for all draw lists are written into ring buffers in
+// one go instead of being re-specified per list, and nothing is written at
+// all when the draw data is identical to the previous frame's. State is
+// saved and restored through GLStateCache rather than glGet* queries.
+// Leaves no vertex array, program or texture bound.
+class ImGuiRenderer
+{
+private:
+	Shader m_Shader;
+	VertexArray m_VertexArray;
+	StreamBuffer m_VertexBuffer;
+	StreamBuffer m_IndexBuffer;
+
+	// Buffer and offset the vertex attributes currently point at
+	unsigned int m_AttribBuffer;
+	unsigned int m_AttribOffset;
+
+	// Copy of the last uploaded vertices and indices. Comparing against it
+	// with memcmp is about as cheap as the upload it can save
+	std::vector<unsigned char> m_LastVertices;
+	std::vector<unsigned char> m_LastIndices;
+
+public:
+	ImGuiRenderer();
+	~ImGuiRenderer();
+
+	void Render(ImDrawData* drawData);
+
+private:
+	int FindFirstChangedList(const ImDrawData* drawData) const;
+	void Upload(ImDrawData* drawData, int firstChangedList);
+};
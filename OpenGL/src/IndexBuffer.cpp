@@ -3,6 +3,7 @@
 #include "IndexBuffer.h"
 
 #include "Renderer.h"
+#include "DeletionQueue.h"
 
 IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
     : m_Count(count)
@@ -16,7 +17,27 @@ IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
 
 IndexBuffer::~IndexBuffer()
 {
-    GLCall(glDeleteBuffers(1, &m_RendererID))
+    DeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+}
+
+IndexBuffer::IndexBuffer(IndexBuffer&& other) noexcept
+    : m_RendererID(other.m_RendererID), m_Count(other.m_Count)
+{
+    other.m_RendererID = 0;
+    other.m_Count = 0;
+}
+
+IndexBuffer& IndexBuffer::operator=(IndexBuffer&& other)
+{
+    if (this != &other)
+    {
+        DeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+        m_RendererID = other.m_RendererID;
+        m_Count = other.m_Count;
+        other.m_RendererID = 0;
+        other.m_Count = 0;
+    }
+    return *this;
 }
 
 void IndexBuffer::Bind() const
@@ -0,0 +1,264 @@
+#include "IndirectBatch.h"
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "DeletionQueue.h"
+
+static const unsigned int CULL_WORKGROUP_SIZE = 64;
+
+// Gribb/Hartmann plane extraction. Planes point inwards, so a sphere is
+// outside when its signed distance to any plane is less than -radius
+static void ExtractFrustumPlanes(const glm::mat4& m, glm::vec4 planes[6])
+{
+	glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+	glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+	glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+	glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+	planes[0] = row3 + row0; // left
+	planes[1] = row3 - row0; // right
+	planes[2] = row3 + row1; // bottom
+	planes[3] = row3 - row1; // top
+	planes[4] = row3 + row2; // near
+	planes[5] = row3 - row2; // far
+
+	for (unsigned int i = 0; i < 6; i++)
+		planes[i] /= glm::length(glm::vec3(planes[i]));
+}
+
+IndirectBatch::IndirectBatch()
+	: m_InstanceCount(0)
+	, m_CommandTemplateBuffer(0)
+	, m_CommandBuffer(0)
+	, m_BoundsBuffer(0)
+	, m_InstanceBuffer(0)
+	, m_VisibleBuffer(0)
+	, m_Built(false)
+{
+}
+
+IndirectBatch::~IndirectBatch()
+{
+	DeletionQueue::Enqueue(GLObjectType::Buffer, m_CommandTemplateBuffer);
+	DeletionQueue::Enqueue(GLObjectType::Buffer, m_CommandBuffer);
+	DeletionQueue::Enqueue(GLObjectType::Buffer, m_BoundsBuffer);
+	DeletionQueue::Enqueue(GLObjectType::Buffer, m_InstanceBuffer);
+	DeletionQueue::Enqueue(GLObjectType::Buffer, m_VisibleBuffer);
+}
+
+bool IndirectBatch::IsSupported()
+{
+	if (!GLEW_VERSION_4_3)
+		return false;
+
+	// Indirect.shader reads the instance buffer from the vertex stage, but
+	// GL 4.3 only guarantees storage blocks in compute shaders
+	int vertexStorageBlocks = 0;
+	GLCall(glGetIntegerv(GL_MAX_VERTEX_SHADER_STORAGE_BLOCKS, &vertexStorageBlocks));
+	return vertexStorageBlocks >= 1;
+}
+
+unsigned int IndirectBatch::AddMesh(const MeshVertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
+{
+	ASSERT(!m_Built);
+	ASSERT(vertexCount > 0 && indexCount > 0);
+
+	DrawElementsIndirectCommand command;
+	command.Count = indexCount;
+	command.InstanceCount = 0;
+	command.FirstIndex = (unsigned int)m_Indices.size();
+	command.BaseVertex = (int)m_Vertices.size();
+	command.BaseInstance = 0; // filled in by Build once instances are known
+	m_Commands.push_back(command);
+
+	// Bounding sphere around the centre of the mesh's AABB
+	glm::vec3 min = vertices[0].Position;
+	glm::vec3 max = vertices[0].Position;
+	for (unsigned int i = 1; i < vertexCount; i++)
+	{
+		min = glm::min(min, vertices[i].Position);
+		max = glm::max(max, vertices[i].Position);
+	}
+	MeshBounds bounds;
+	bounds.Center = (min + max) * 0.5f;
+	bounds.Radius = 0.0f;
+	for (unsigned int i = 0; i < vertexCount; i++)
+		bounds.Radius = glm::max(bounds.Radius, glm::length(vertices[i].Position - bounds.Center));
+	m_Bounds.push_back(bounds);
+
+	m_Vertices.insert(m_Vertices.end(), vertices, vertices + vertexCount);
+	m_Indices.insert(m_Indices.end(), indices, indices + indexCount);
+
+	return (unsigned int)m_Commands.size() - 1;
+}
+
+void IndirectBatch::AddInstance(unsigned int meshIndex, const glm::mat4& model)
+{
+	ASSERT(!m_Built);
+	ASSERT(meshIndex < m_Commands.size());
+
+	InstanceData instance = {};
+	instance.Model = model;
+	instance.MeshIndex = meshIndex;
+	m_Instances.push_back(instance);
+	m_InstanceCount++;
+}
+
+void IndirectBatch::Build()
+{
+	ASSERT(!m_Built);
+	m_Built = true;
+
+	// Each mesh gets a contiguous range of the visible list, starting at
+	// its command's BaseInstance. The cull shader appends into that range
+	std::vector<unsigned int> meshInstanceCounts(m_Commands.size(), 0);
+	for (const auto& instance : m_Instances)
+		meshInstanceCounts[instance.MeshIndex]++;
+
+	unsigned int baseInstance = 0;
+	for (unsigned int i = 0; i < m_Commands.size(); i++)
+	{
+		m_Commands[i].BaseInstance = baseInstance;
+		baseInstance += meshInstanceCounts[i];
+	}
+
+	m_VertexArray = std::make_unique<VertexArray>();
+	m_VertexBuffer = std::make_unique<VertexBuffer>(m_Vertices.data(), (unsigned int)(m_Vertices.size() * sizeof(MeshVertex)));
+
+	VertexBufferLayout layout;
+	layout.Push<float>(3);
+	layout.Push<float>(2);
+	m_VertexArray->AddBuffer(*m_VertexBuffer, layout);
+
+	// Created while the vertex array is bound so it is stored in the VAO
+	m_IndexBuffer = std::make_unique<IndexBuffer>(m_Indices.data(), (unsigned int)m_Indices.size());
+
+	// The visible list is read as a per instance attribute. glMultiDrawElementsIndirect
+	// offsets instanced attributes by BaseInstance, so each draw starts at its own range
+	GLCall(glGenBuffers(1, &m_VisibleBuffer));
+	GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_VisibleBuffer));
+	GLCall(glBufferData(GL_ARRAY_BUFFER, m_InstanceCount * sizeof(unsigned int), nullptr, GL_DYNAMIC_COPY));
+	GLCall(glEnableVertexAttribArray(2));
+	GLCall(glVertexAttribIPointer(2, 1, GL_UNSIGNED_INT, sizeof(unsigned int), nullptr));
+	GLCall(glVertexAttribDivisor(2, 1));
+	m_VertexArray->Unbind();
+
+	GLCall(glGenBuffers(1, &m_InstanceBuffer));
+	GLCall(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_InstanceBuffer));
+	GLCall(glBufferData(GL_SHADER_STORAGE_BUFFER, m_InstanceCount * sizeof(InstanceData), m_Instances.data(), GL_STATIC_DRAW));
+
+	GLCall(glGenBuffers(1, &m_BoundsBuffer));
+	GLCall(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_BoundsBuffer));
+	GLCall(glBufferData(GL_SHADER_STORAGE_BUFFER, m_Bounds.size() * sizeof(MeshBounds), m_Bounds.data(), GL_STATIC_DRAW));
+	GLCall(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+
+	GLCall(glGenBuffers(1, &m_CommandTemplateBuffer));
+	GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_CommandTemplateBuffer));
+	GLCall(glBufferData(GL_COPY_READ_BUFFER, m_Commands.size() * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_STATIC_COPY));
+	GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+
+	GLCall(glGenBuffers(1, &m_CommandBuffer));
+	GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer));
+	GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Commands.size() * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_DYNAMIC_COPY));
+	GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+
+	// Everything lives on the GPU now
+	m_Vertices = std::vector<MeshVertex>();
+	m_Indices = std::vector<unsigned int>();
+	m_Instances = std::vector<InstanceData>();
+}
+
+void IndirectBatch::Cull(Shader& cullShader, const glm::mat4& viewProjection, bool frustumCulling) const
+{
+	ASSERT(m_Built);
+
+	// Reset every InstanceCount to zero with a GPU side copy
+	GLCall(glBindBuffer(GL_COPY_READ_BUFFER, m_CommandTemplateBuffer));
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_CommandBuffer));
+	GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, m_Commands.size() * sizeof(DrawElementsIndirectCommand)));
+	GLCall(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+	GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+	// All zero planes never reject anything
+	glm::vec4 planes[6] = {};
+	if (frustumCulling)
+		ExtractFrustumPlanes(viewProjection, planes);
+
+	cullShader.Bind();
+	cullShader.SetUniform4fv("u_Planes", 6, planes);
+	cullShader.SetUniform1ui("u_InstanceCount", m_InstanceCount);
+
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_InstanceBuffer));
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_BoundsBuffer));
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_CommandBuffer));
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_VisibleBuffer));
+
+	GLCall(glDispatchCompute((m_InstanceCount + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE, 1, 1));
+
+	// The draw reads the commands and the visible list written above
+	GLCall(glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT));
+}
+
+void IndirectBatch::Bind() const
+{
+	m_VertexArray->Bind();
+	m_IndexBuffer->Bind();
+	GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer));
+	// The vertex shader fetches model matrices from the instance buffer
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_InstanceBuffer));
+}
+
+std::vector<unsigned int> IndirectBatch::ReadVisibleCounts() const
+{
+	ASSERT(m_Built);
+
+	// Make the cull shader's atomic writes visible to glGetBufferSubData
+	GLCall(glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT));
+
+	std::vector<DrawElementsIndirectCommand> commands(m_Commands.size());
+	GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer));
+	GLCall(glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data()));
+	GLCall(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+
+	std::vector<unsigned int> counts;
+	for (const auto& command : commands)
+		counts.push_back(command.InstanceCount);
+	return counts;
+}
+
+void IndirectBatch::CountVisible(const glm::mat4& viewProjection, bool frustumCulling, float tolerance,
+	std::vector<unsigned int>& minCounts, std::vector<unsigned int>& maxCounts) const
+{
+	ASSERT(m_Built);
+
+	// The CPU copy was dropped in Build, read the instances back instead
+	std::vector<InstanceData> instances(m_InstanceCount);
+	GLCall(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_InstanceBuffer));
+	GLCall(glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, instances.size() * sizeof(InstanceData), instances.data()));
+	GLCall(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+
+	glm::vec4 planes[6] = {};
+	if (frustumCulling)
+		ExtractFrustumPlanes(viewProjection, planes);
+
+	minCounts.assign(m_Commands.size(), 0);
+	maxCounts.assign(m_Commands.size(), 0);
+	for (const auto& instance : instances)
+	{
+		const MeshBounds& bounds = m_Bounds[instance.MeshIndex];
+		const glm::mat4& model = instance.Model;
+		glm::vec3 center = glm::vec3(model * glm::vec4(bounds.Center, 1.0f));
+		float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		float radius = bounds.Radius * scale;
+
+		bool certain = true;
+		bool possible = true;
+		for (unsigned int i = 0; i < 6; i++)
+		{
+			float distance = glm::dot(glm::vec3(planes[i]), center) + planes[i].w;
+			certain = certain && distance >= -radius + tolerance;
+			possible = possible && distance >= -radius - tolerance;
+		}
+		minCounts[instance.MeshIndex] += certain ? 1 : 0;
+		maxCounts[instance.MeshIndex] += possible ? 1 : 0;
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "glm/glm.hpp"
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+
+struct MeshVertex
+{
+	glm::vec3 Position;
+	glm::vec2 TexCoord;
+};
+
+// Layouts below are mirrored by the std430 blocks in
+// res/shaders/Cull.shader and res/shaders/Indirect.shader
+
+// Matches the command struct glMultiDrawElementsIndirect reads
+struct DrawElementsIndirectCommand
+{
+	unsigned int Count;
+	unsigned int InstanceCount;
+	unsigned int FirstIndex;
+	int          BaseVertex;
+	unsigned int BaseInstance;
+};
+
+struct MeshBounds
+{
+	glm::vec3 Center;
+	float     Radius;
+};
+
+struct InstanceData
+{
+	glm::mat4    Model;
+	unsigned int MeshIndex;
+	unsigned int Padding[3];
+};
+
+// Stores many meshes in one shared vertex/index buffer and draws every
+// instance of every mesh with a single glMultiDrawElementsIndirect call.
+// Frustum culling runs in a compute shader which fills in the instance
+// counts of the indirect commands, so the CPU never touches per-object
+// data after Build(). Requires GL 4.3 (compute + multi draw indirect).
+class IndirectBatch
+{
+private:
+	std::vector<MeshVertex> m_Vertices;
+	std::vector<unsigned int> m_Indices;
+	std::vector<DrawElementsIndirectCommand> m_Commands;
+	std::vector<MeshBounds> m_Bounds;
+	std::vector<InstanceData> m_Instances;
+	unsigned int m_InstanceCount;
+
+	std::unique_ptr<VertexArray> m_VertexArray;
+	std::unique_ptr<VertexBuffer> m_VertexBuffer;
+	std::unique_ptr<IndexBuffer> m_IndexBuffer;
+
+	// Commands with InstanceCount = 0, copied over m_CommandBuffer every frame
+	unsigned int m_CommandTemplateBuffer;
+	unsigned int m_CommandBuffer;
+	unsigned int m_BoundsBuffer;
+	unsigned int m_InstanceBuffer;
+	// Indices of visible instances, grouped per mesh at each command's BaseInstance
+	unsigned int m_VisibleBuffer;
+
+	bool m_Built;
+
+public:
+	IndirectBatch();
+	~IndirectBatch();
+
+	// Returns the mesh index to pass to AddInstance
+	unsigned int AddMesh(const MeshVertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
+	void AddInstance(unsigned int meshIndex, const glm::mat4& model);
+
+	// Uploads all meshes and instances. Meshes and instances can't be added afterwards
+	void Build();
+
+	// Dispatches the culling compute shader for the given view projection.
+	// With frustumCulling off every instance is written out as visible
+	void Cull(Shader& cullShader, const glm::mat4& viewProjection, bool frustumCulling = true) const;
+	void Bind() const;
+
+	// Reads back the per mesh instance counts the last Cull wrote. Stalls
+	// until the GPU is done, so it's for checks rather than every frame
+	std::vector<unsigned int> ReadVisibleCounts() const;
+	// The cull shader's sphere test done on the CPU, per mesh. Instances
+	// within tolerance of a plane could round either way on the GPU, so
+	// they are only counted in maxCounts
+	void CountVisible(const glm::mat4& viewProjection, bool frustumCulling, float tolerance,
+		std::vector<unsigned int>& minCounts, std::vector<unsigned int>& maxCounts) const;
+
+	static bool IsSupported();
+
+	inline unsigned int GetMeshCount() const { return (unsigned int)m_Commands.size(); }
+	inline unsigned int GetInstanceCount() const { return m_InstanceCount; }
+};
@@ -0,0 +1,219 @@
+#include "ParticleSystem.h"
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "GLStateCache.h"
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define PARTICLES_SSE 1
+#include <xmmintrin.h>
+#endif
+
+static const unsigned int COMPUTE_WORKGROUP_SIZE = 256;
+
+// Must match the shaders so every backend spawns the same particles
+static unsigned int Hash(unsigned int x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+static float Random(unsigned int id, unsigned int k, unsigned int seed)
+{
+	return (float)Hash(id * 3u + k + Hash(seed)) / 4294967295.0f;
+}
+
+static const float QUAD_CORNERS[] = {
+	-0.5f, -0.5f,
+	 0.5f, -0.5f,
+	-0.5f,  0.5f,
+	 0.5f,  0.5f,
+};
+
+ParticleSystem::ParticleSystem(unsigned int count, ParticleBackend backend)
+	: m_Backend(backend)
+	, m_Count(count)
+	, m_Seed(0)
+	, m_RenderShader("res/shaders/Particle.shader")
+	, m_QuadBuffer(QUAD_CORNERS, sizeof(QUAD_CORNERS))
+	, m_Current(0)
+	, Emitter(480.0f, 20.0f, 0.0f)
+	, Gravity(0.0f, -300.0f, 0.0f)
+	, Lifetime(3.0f)
+	, Speed(500.0f)
+	, Size(2.0f)
+{
+	ASSERT(IsSupported(backend));
+
+	// Stagger lifetimes so particles don't all respawn on the same frame
+	std::vector<Particle> particles(m_Count);
+	for (unsigned int i = 0; i < m_Count; i++)
+	{
+		particles[i] = Spawn(i);
+		particles[i].PositionLife.w *= Random(i, 3u, m_Seed);
+	}
+
+	unsigned int bufferCount = m_Backend == ParticleBackend::TransformFeedback ? 2 : 1;
+	unsigned int usage = m_Backend == ParticleBackend::CPU ? GL_STREAM_DRAW : GL_DYNAMIC_COPY;
+	m_ParticleBuffers.reserve(bufferCount);
+	for (unsigned int i = 0; i < bufferCount; i++)
+		m_ParticleBuffers.emplace_back(particles.data(), m_Count * (unsigned int)sizeof(Particle), usage);
+
+	VertexBufferLayout quadLayout;
+	quadLayout.Push<float>(2);
+	VertexBufferLayout particleLayout;
+	particleLayout.Push<float>(4);
+	particleLayout.Push<float>(4);
+
+	m_RenderArrays.resize(bufferCount);
+	for (unsigned int i = 0; i < bufferCount; i++)
+	{
+		m_RenderArrays[i].AddBuffer(m_QuadBuffer, quadLayout);
+		m_RenderArrays[i].AddBuffer(m_ParticleBuffers[i], particleLayout, 1, 1);
+	}
+
+	switch (m_Backend)
+	{
+		case ParticleBackend::Compute:
+			m_UpdateShader = std::make_unique<Shader>("res/shaders/ParticleCompute.shader");
+			break;
+		case ParticleBackend::TransformFeedback:
+			m_UpdateShader = std::make_unique<Shader>("res/shaders/ParticleFeedback.shader",
+				std::vector<std::string>{ "o_PositionLife", "o_Velocity" });
+			m_UpdateArrays.resize(bufferCount);
+			for (unsigned int i = 0; i < bufferCount; i++)
+				m_UpdateArrays[i].AddBuffer(m_ParticleBuffers[i], particleLayout, 1);
+			break;
+		case ParticleBackend::CPU:
+			m_CpuParticles = std::move(particles);
+			break;
+	}
+	m_RenderArrays.back().Unbind();
+}
+
+ParticleSystem::~ParticleSystem()
+{
+}
+
+bool ParticleSystem::IsSupported(ParticleBackend backend)
+{
+	if (backend == ParticleBackend::Compute)
+		return GLEW_VERSION_4_3;
+	return true;
+}
+
+Particle ParticleSystem::Spawn(unsigned int id) const
+{
+	float angle = glm::mix(-0.35f, 0.35f, Random(id, 0u, m_Seed));
+	float speed = Speed * glm::mix(0.5f, 1.0f, Random(id, 1u, m_Seed));
+
+	Particle particle;
+	particle.PositionLife = glm::vec4(Emitter, Lifetime * glm::mix(0.25f, 1.0f, Random(id, 2u, m_Seed)));
+	particle.Velocity = glm::vec4(std::sin(angle) * speed, std::cos(angle) * speed, 0.0f, -1.0f);
+	return particle;
+}
+
+void ParticleSystem::Update(float deltaTime)
+{
+	m_Seed++;
+	switch (m_Backend)
+	{
+		case ParticleBackend::Compute:           UpdateCompute(deltaTime); break;
+		case ParticleBackend::TransformFeedback: UpdateTransformFeedback(deltaTime); break;
+		case ParticleBackend::CPU:               UpdateCPU(deltaTime); break;
+	}
+}
+
+void ParticleSystem::SetUpdateUniforms(float deltaTime)
+{
+	m_UpdateShader->Bind();
+	m_UpdateShader->SetUniform1ui("u_Seed", m_Seed);
+	m_UpdateShader->SetUniform1f("u_DeltaTime", deltaTime);
+	m_UpdateShader->SetUniform1f("u_Lifetime", Lifetime);
+	m_UpdateShader->SetUniform1f("u_Speed", Speed);
+	m_UpdateShader->SetUniform3f("u_Emitter", Emitter.x, Emitter.y, Emitter.z);
+	m_UpdateShader->SetUniform3f("u_Gravity", Gravity.x, Gravity.y, Gravity.z);
+}
+
+void ParticleSystem::UpdateCompute(float deltaTime)
+{
+	SetUpdateUniforms(deltaTime);
+	m_UpdateShader->SetUniform1ui("u_Count", m_Count);
+
+	GLCall(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_ParticleBuffers[0].GetRendererID()));
+	GLCall(glDispatchCompute((m_Count + COMPUTE_WORKGROUP_SIZE - 1) / COMPUTE_WORKGROUP_SIZE, 1, 1));
+	// Rendering reads the particles as instanced vertex attributes
+	GLCall(glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT));
+}
+
+void ParticleSystem::UpdateTransformFeedback(float deltaTime)
+{
+	unsigned int next = 1 - m_Current;
+
+	SetUpdateUniforms(deltaTime);
+	m_UpdateArrays[m_Current].Bind();
+	GLCall(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, m_ParticleBuffers[next].GetRendererID()));
+
+	// Only the captured vertex outputs are wanted
+	GLStateCache::SetRasterizerDiscard(true);
+	GLCall(glBeginTransformFeedback(GL_POINTS));
+	GLCall(glDrawArrays(GL_POINTS, 0, m_Count));
+	GLCall(glEndTransformFeedback());
+	GLStateCache::SetRasterizerDiscard(false);
+
+	GLCall(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0));
+	m_UpdateArrays[m_Current].Unbind();
+	m_Current = next;
+}
+
+void ParticleSystem::UpdateCPU(float deltaTime)
+{
+	// Velocity.w is -1 and gravity.w is 0, so the same four wide multiply-add
+	// moves the particle and counts its life down
+	glm::vec4 gravity(Gravity * deltaTime, 0.0f);
+#if PARTICLES_SSE
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	const __m128 g = _mm_loadu_ps(&gravity.x);
+#endif
+	for (unsigned int i = 0; i < m_Count; i++)
+	{
+		Particle& p = m_CpuParticles[i];
+#if PARTICLES_SSE
+		__m128 velocity = _mm_add_ps(_mm_loadu_ps(&p.Velocity.x), g);
+		__m128 position = _mm_add_ps(_mm_loadu_ps(&p.PositionLife.x), _mm_mul_ps(velocity, dt));
+		_mm_storeu_ps(&p.Velocity.x, velocity);
+		_mm_storeu_ps(&p.PositionLife.x, position);
+#else
+		p.Velocity += gravity;
+		p.PositionLife += p.Velocity * deltaTime;
+#endif
+		if (p.PositionLife.w <= 0.0f)
+			p = Spawn(i);
+	}
+
+	m_ParticleBuffers[0].Bind();
+	GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, m_Count * sizeof(Particle), m_CpuParticles.data()));
+}
+
+void ParticleSystem::Render(const glm::mat4& viewProjection)
+{
+	GLStateCache::State previous = GLStateCache::Get();
+	// Additive blending so dense areas glow
+	GLStateCache::SetBlend(true);
+	GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE);
+
+	m_RenderShader.Bind();
+	m_RenderShader.SetUniformMat4f("u_ViewProjection", viewProjection);
+	m_RenderShader.SetUniform1f("u_Size", Size);
+	m_RenderShader.SetUniform1f("u_Lifetime", Lifetime);
+
+	m_RenderArrays[m_Current].Bind();
+	GLCall(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_Count));
+	m_RenderArrays[m_Current].Unbind();
+
+	GLStateCache::Apply(previous);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include "glm/glm.hpp"
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "Shader.h"
+
+// Mirrors the Particle struct in res/shaders/ParticleCompute.shader
+struct Particle
+{
+	glm::vec4 PositionLife; // w = remaining life in seconds
+	glm::vec4 Velocity;     // w = -1, so integrating position counts life down
+};
+
+enum class ParticleBackend
+{
+	Compute,           // GL 4.3, updated in place in a storage buffer
+	TransformFeedback, // GL 3.3, ping-pongs between two buffers
+	CPU,               // SIMD reference, uploaded every frame
+};
+
+// Fountain of particles simulated and drawn as instanced quads. On the GPU
+// backends particle state never leaves GPU memory after the initial upload.
+class ParticleSystem
+{
+private:
+	ParticleBackend m_Backend;
+	unsigned int m_Count;
+	unsigned int m_Seed;
+
+	std::unique_ptr<Shader> m_UpdateShader;
+	Shader m_RenderShader;
+	VertexBuffer m_QuadBuffer;
+
+	// One buffer for Compute and CPU, two for TransformFeedback
+	std::vector<VertexBuffer> m_ParticleBuffers;
+	// Per buffer: instanced for drawing, per vertex for the feedback update
+	std::vector<VertexArray> m_RenderArrays;
+	std::vector<VertexArray> m_UpdateArrays;
+	unsigned int m_Current;
+
+	std::vector<Particle> m_CpuParticles;
+
+public:
+	glm::vec3 Emitter;
+	glm::vec3 Gravity;
+	float Lifetime;
+	float Speed;
+	float Size;
+
+	ParticleSystem(unsigned int count, ParticleBackend backend);
+	~ParticleSystem();
+
+	void Update(float deltaTime);
+	void Render(const glm::mat4& viewProjection);
+
+	static bool IsSupported(ParticleBackend backend);
+
+	inline unsigned int GetCount() const { return m_Count; }
+
+private:
+	void UpdateCompute(float deltaTime);
+	void UpdateTransformFeedback(float deltaTime);
+	void UpdateCPU(float deltaTime);
+	void SetUpdateUniforms(float deltaTime);
+	Particle Spawn(unsigned int id) const;
+};
@@ -0,0 +1,218 @@
+#include "PostProcess.h"
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "imgui/imgui.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static const char* TONEMAPPER_NAMES[] = { "None", "Reinhard", "ACES" };
+
+PostProcess::PostProcess()
+	: m_DownsampleShader("res/shaders/BloomDownsample.shader")
+	, m_UpsampleShader("res/shaders/BloomUpsample.shader")
+	, m_TonemapShader("res/shaders/Tonemap.shader")
+	, m_FXAAShader("res/shaders/FXAA.shader")
+{
+}
+
+PostProcess::~PostProcess()
+{
+}
+
+void PostProcess::AddPasses(FrameGraph& graph, FrameGraphResource hdrInput, FrameGraphResource output)
+{
+	bool bloom = m_Settings.Bloom;
+	unsigned int bloomLevels = 0;
+	FrameGraphResource bloomResult = bloom ? AddBloomPasses(graph, hdrInput, bloomLevels) : hdrInput;
+	// The up chain sums every level, keep the intensity independent of how many there are
+	float bloomScale = bloomLevels > 0 ? 1.0f / bloomLevels : 0.0f;
+
+	// FXAA needs the tonemapped image, so tonemap into an intermediate target first
+	RenderTargetDesc outputDesc = graph.GetDesc(output);
+	FrameGraphResource tonemapped = output;
+	if (m_Settings.FXAA)
+		tonemapped = graph.CreateRenderTarget("LDR", { outputDesc.Width, outputDesc.Height, GL_RGBA8 });
+
+	std::vector<FrameGraphResource> tonemapInputs = { hdrInput };
+	if (bloom)
+		tonemapInputs.push_back(bloomResult);
+	graph.AddPass("Tonemap", tonemapInputs, tonemapped, [this, bloom, bloomScale]()
+	{
+		m_TonemapShader.Bind();
+		m_TonemapShader.SetUniform1i("u_Scene", 0);
+		// Without bloom there is nothing in slot 1, sample the scene at zero weight
+		m_TonemapShader.SetUniform1i("u_Bloom", bloom ? 1 : 0);
+		m_TonemapShader.SetUniform1f("u_BloomIntensity", bloom ? m_Settings.BloomIntensity * bloomScale : 0.0f);
+		m_TonemapShader.SetUniform1f("u_Exposure", m_Settings.Exposure);
+		m_TonemapShader.SetUniform1i("u_Tonemapper", (int)m_Settings.Operator);
+		DrawFullscreen();
+	});
+
+	if (m_Settings.FXAA)
+	{
+		float texelX = 1.0f / outputDesc.Width;
+		float texelY = 1.0f / outputDesc.Height;
+		graph.AddPass("FXAA", { tonemapped }, output, [this, texelX, texelY]()
+		{
+			m_FXAAShader.Bind();
+			m_FXAAShader.SetUniform1i("u_Source", 0);
+			m_FXAAShader.SetUniform2f("u_TexelSize", texelX, texelY);
+			DrawFullscreen();
+		});
+	}
+}
+
+FrameGraphResource PostProcess::AddBloomPasses(FrameGraph& graph, FrameGraphResource hdrInput, unsigned int& levelCount)
+{
+	// Each level is half the size of the one above it
+	std::vector<RenderTargetDesc> levels;
+	RenderTargetDesc desc = graph.GetDesc(hdrInput);
+	for (int i = 0; i < m_Settings.BloomLevels && desc.Width > 1 && desc.Height > 1; i++)
+	{
+		desc.Width /= 2;
+		desc.Height /= 2;
+		desc.Format = GL_RGBA16F;
+		levels.push_back(desc);
+	}
+	levelCount = (unsigned int)levels.size();
+
+	// Down the chain, keeping only the bright parts on the first level
+	std::vector<FrameGraphResource> down;
+	FrameGraphResource source = hdrInput;
+	for (unsigned int i = 0; i < levels.size(); i++)
+	{
+		std::string name = "Bloom down " + std::to_string(i);
+		FrameGraphResource target = graph.CreateRenderTarget(name, levels[i]);
+		RenderTargetDesc sourceDesc = graph.GetDesc(source);
+		float texelX = 1.0f / sourceDesc.Width;
+		float texelY = 1.0f / sourceDesc.Height;
+		bool prefilter = i == 0;
+		graph.AddPass(name, { source }, target, [this, texelX, texelY, prefilter]()
+		{
+			m_DownsampleShader.Bind();
+			m_DownsampleShader.SetUniform1i("u_Source", 0);
+			m_DownsampleShader.SetUniform2f("u_TexelSize", texelX, texelY);
+			m_DownsampleShader.SetUniform1i("u_Prefilter", prefilter ? 1 : 0);
+			m_DownsampleShader.SetUniform1f("u_Threshold", m_Settings.BloomThreshold);
+			DrawFullscreen();
+		});
+		down.push_back(target);
+		source = target;
+	}
+
+	// And back up again, each level adding the down target of its own size
+	// so the tight glow of the larger levels survives next to the wide one
+	// of the smaller levels
+	for (int i = (int)levels.size() - 2; i >= 0; i--)
+	{
+		std::string name = "Bloom up " + std::to_string(i);
+		FrameGraphResource target = graph.CreateRenderTarget(name, levels[i]);
+		RenderTargetDesc sourceDesc = graph.GetDesc(source);
+		float texelX = 1.0f / sourceDesc.Width;
+		float texelY = 1.0f / sourceDesc.Height;
+		graph.AddPass(name, { source, down[i] }, target, [this, texelX, texelY]()
+		{
+			m_UpsampleShader.Bind();
+			m_UpsampleShader.SetUniform1i("u_Source", 0);
+			m_UpsampleShader.SetUniform1i("u_Current", 1);
+			m_UpsampleShader.SetUniform2f("u_TexelSize", texelX, texelY);
+			DrawFullscreen();
+		});
+		source = target;
+	}
+
+	return source;
+}
+
+bool PostProcess::RunAliasingCheck(int width, int height)
+{
+	// Each target is read only by the pass after the one writing it, so
+	// target i can reuse the texture of target i - 2
+	const unsigned int chainLength = 4;
+	const float clearColor[] = { 0.25f, 0.5f, 0.75f };
+
+	FrameGraph graph;
+	FrameGraphResource source = graph.CreateRenderTarget("Chain 0", { width, height, GL_RGBA16F });
+	graph.AddPass("Chain 0", {}, source, [&clearColor]()
+	{
+		GLCall(glClearColor(clearColor[0], clearColor[1], clearColor[2], 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+	});
+
+	float texelX = 1.0f / width;
+	float texelY = 1.0f / height;
+	for (unsigned int i = 1; i <= chainLength; i++)
+	{
+		std::string name = "Chain " + std::to_string(i);
+		FrameGraphResource target = i < chainLength
+			? graph.CreateRenderTarget(name, { width, height, GL_RGBA16F })
+			: graph.ImportBackbuffer("Backbuffer", width, height);
+		// FXAA leaves a flat colour as it is
+		graph.AddPass(name, { source }, target, [this, texelX, texelY]()
+		{
+			m_FXAAShader.Bind();
+			m_FXAAShader.SetUniform1i("u_Source", 0);
+			m_FXAAShader.SetUniform2f("u_TexelSize", texelX, texelY);
+			DrawFullscreen();
+		});
+		source = target;
+	}
+
+	graph.Compile();
+	graph.Execute();
+
+	// Fewer than two textures would mean a pass reading and writing the same one
+	bool aliased = graph.GetTransientCount() == chainLength && graph.GetPhysicalCount() == 2;
+	std::cout << "[Aliasing check] " << graph.GetTransientCount() << " render targets backed by "
+		<< graph.GetPhysicalCount() << " textures, expected " << chainLength << " in 2"
+		<< (aliased ? "" : "  MISMATCH") << std::endl;
+
+	unsigned char pixel[4];
+	GLCall(glReadPixels(width / 2, height / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel));
+	bool colorMatches = true;
+	std::cout << "[Aliasing check] backbuffer";
+	for (int c = 0; c < 3; c++)
+	{
+		int expected = (int)(clearColor[c] * 255.0f + 0.5f);
+		colorMatches = colorMatches && std::abs(pixel[c] - expected) <= 1;
+		std::cout << " " << (int)pixel[c] << "/" << expected;
+	}
+	std::cout << (colorMatches ? "" : "  MISMATCH") << std::endl;
+
+	bool passed = aliased && colorMatches;
+	std::cout << "[Aliasing check] " << (passed ? "PASSED" : "FAILED") << std::endl;
+	return passed;
+}
+
+void PostProcess::DrawFullscreen() const
+{
+	// Every pass overwrites its whole target
+	GLStateCache::State previous = GLStateCache::Get();
+	GLStateCache::SetBlend(false);
+	m_FullscreenVertexArray.Bind();
+	GLCall(glDrawArrays(GL_TRIANGLES, 0, 3));
+	// Keeps later index buffer binds from landing in this vertex array
+	m_FullscreenVertexArray.Unbind();
+	GLStateCache::Apply(previous);
+}
+
+bool PostProcess::OnImGuiRender()
+{
+	bool changed = false;
+	changed |= ImGui::Checkbox("Bloom", &m_Settings.Bloom);
+	if (m_Settings.Bloom)
+	{
+		changed |= ImGui::SliderInt("Bloom levels", &m_Settings.BloomLevels, 1, 8);
+		ImGui::SliderFloat("Bloom threshold", &m_Settings.BloomThreshold, 0.0f, 4.0f);
+		ImGui::SliderFloat("Bloom intensity", &m_Settings.BloomIntensity, 0.0f, 4.0f);
+	}
+
+	int tonemapper = (int)m_Settings.Operator;
+	if (ImGui::Combo("Tonemapper", &tonemapper, TONEMAPPER_NAMES, IM_ARRAYSIZE(TONEMAPPER_NAMES)))
+		m_Settings.Operator = (Tonemapper)tonemapper;
+	ImGui::SliderFloat("Exposure", &m_Settings.Exposure, 0.1f, 8.0f);
+
+	changed |= ImGui::Checkbox("FXAA", &m_Settings.FXAA);
+	return changed;
+}
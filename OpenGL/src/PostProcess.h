@@ -0,0 +1,65 @@
+#pragma once
+#include "FrameGraph.h"
+#include "Shader.h"
+#include "VertexArray.h"
+
+enum class Tonemapper
+{
+	None,     // clamp, the scene looks the same as without post processing
+	Reinhard,
+	ACES,
+};
+
+struct PostProcessSettings
+{
+	// Changing these adds or removes passes, so the graph has to be rebuilt
+	bool Bloom = true;
+	int BloomLevels = 5;
+	bool FXAA = false;
+
+	// Read every frame
+	float BloomThreshold = 1.0f;
+	float BloomIntensity = 0.8f;
+	Tonemapper Operator = Tonemapper::None;
+	float Exposure = 1.0f;
+};
+
+// Adds the built in post processing passes to a FrameGraph: a bloom
+// downsample/upsample chain, tonemapping and FXAA. Every pass draws one
+// fullscreen triangle reading the pass inputs from texture slots 0, 1, ...
+class PostProcess
+{
+private:
+	PostProcessSettings m_Settings;
+
+	Shader m_DownsampleShader;
+	Shader m_UpsampleShader;
+	Shader m_TonemapShader;
+	Shader m_FXAAShader;
+	// Core profile draws need a vertex array bound, even with no attributes
+	VertexArray m_FullscreenVertexArray;
+
+public:
+	PostProcess();
+	~PostProcess();
+
+	// Tonemaps the HDR input into output, with bloom and FXAA on the way
+	// when enabled. The passes keep a pointer to this, so it has to outlive
+	// the graph's use of them
+	void AddPasses(FrameGraph& graph, FrameGraphResource hdrInput, FrameGraphResource output);
+
+	// Returns true when a setting that needs the graph rebuilt was changed
+	bool OnImGuiRender();
+
+	// Non interactive: runs a chain of same size passes into the backbuffer,
+	// where every other target can reuse a texture, and checks that the
+	// graph backs the four targets with exactly two textures and that the
+	// colour the first pass wrote reaches the backbuffer unchanged. Prints
+	// the results and returns false if either doesn't hold
+	bool RunAliasingCheck(int width, int height);
+
+private:
+	// levelCount is set to the number of levels actually added
+	FrameGraphResource AddBloomPasses(FrameGraph& graph, FrameGraphResource hdrInput, unsigned int& levelCount);
+	void DrawFullscreen() const;
+};
@@ -0,0 +1,92 @@
+#include "RenderTarget.h"
+#include "Renderer.h"
+#include "DeletionQueue.h"
+#include <iostream>
+
+RenderTarget::RenderTarget(int width, int height, unsigned int format)
+	: m_FramebufferID(0)
+	, m_TextureID(0)
+	, m_Width(width)
+	, m_Height(height)
+	, m_Format(format)
+{
+	GLCall(glGenTextures(1, &m_TextureID));
+	GLCall(glBindTexture(GL_TEXTURE_2D, m_TextureID));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+	// The pixel type only matters for the (absent) initial data
+	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+
+	GLCall(glGenFramebuffers(1, &m_FramebufferID));
+	GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID));
+	GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_TextureID, 0));
+	GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+		std::cout << "Warning: render target " << width << "x" << height << " is incomplete (" << status << ")" << std::endl;
+	Unbind();
+}
+
+RenderTarget::~RenderTarget()
+{
+	DeletionQueue::Enqueue(GLObjectType::Framebuffer, m_FramebufferID);
+	DeletionQueue::Enqueue(GLObjectType::Texture, m_TextureID);
+}
+
+RenderTarget::RenderTarget(RenderTarget&& other) noexcept
+	: m_FramebufferID(other.m_FramebufferID)
+	, m_TextureID(other.m_TextureID)
+	, m_Width(other.m_Width)
+	, m_Height(other.m_Height)
+	, m_Format(other.m_Format)
+{
+	other.m_FramebufferID = 0;
+	other.m_TextureID = 0;
+}
+
+RenderTarget& RenderTarget::operator=(RenderTarget&& other)
+{
+	if (this != &other)
+	{
+		DeletionQueue::Enqueue(GLObjectType::Framebuffer, m_FramebufferID);
+		DeletionQueue::Enqueue(GLObjectType::Texture, m_TextureID);
+		m_FramebufferID = other.m_FramebufferID;
+		m_TextureID = other.m_TextureID;
+		m_Width = other.m_Width;
+		m_Height = other.m_Height;
+		m_Format = other.m_Format;
+		other.m_FramebufferID = 0;
+		other.m_TextureID = 0;
+	}
+	return *this;
+}
+
+void RenderTarget::Bind() const
+{
+	GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID));
+}
+
+void RenderTarget::Unbind() const
+{
+	GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void RenderTarget::BindTexture(unsigned int slot) const
+{
+	GLCall(glActiveTexture(GL_TEXTURE0 + slot));
+	GLCall(glBindTexture(GL_TEXTURE_2D, m_TextureID));
+}
+
+unsigned int RenderTarget::GetSizeInBytes() const
+{
+	unsigned int bytesPerPixel = 4;
+	switch (m_Format)
+	{
+		case GL_RGBA16F: bytesPerPixel = 8; break;
+		case GL_RGBA32F: bytesPerPixel = 16; break;
+		case GL_R11F_G11F_B10F: bytesPerPixel = 4; break;
+	}
+	return m_Width * m_Height * bytesPerPixel;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// A framebuffer with a single colour texture attachment that can be
+// rendered to and then sampled from
+class RenderTarget
+{
+private:
+	unsigned int m_FramebufferID;
+	unsigned int m_TextureID;
+	int m_Width, m_Height;
+	unsigned int m_Format;
+
+public:
+	// format is the texture's internal format, e.g. GL_RGBA8 or GL_RGBA16F
+	RenderTarget(int width, int height, unsigned int format);
+	~RenderTarget();
+
+	RenderTarget(const RenderTarget&) = delete;
+	RenderTarget& operator=(const RenderTarget&) = delete;
+	RenderTarget(RenderTarget&& other) noexcept;
+	RenderTarget& operator=(RenderTarget&& other);
+
+	void Bind() const;
+	void Unbind() const;
+	void BindTexture(unsigned int slot = 0) const;
+
+	inline int GetWidth() const { return m_Width; }
+	inline int GetHeight() const { return m_Height; }
+	inline unsigned int GetFormat() const { return m_Format; }
+	unsigned int GetSizeInBytes() const;
+};
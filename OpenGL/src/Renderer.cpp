@@ -1,4 +1,5 @@
 #include "Renderer.h"
+#include "IndirectBatch.h"
 #include <iostream>
 
 void GLClearError()
@@ -35,3 +36,22 @@ void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader&
     // glDrawElements instead of glDrawArrays
     GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
 }
+
+void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count)
+{
+    ASSERT(count <= ib.GetCount());
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+
+    GLCall(glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr));
+}
+
+void Renderer::DrawIndirect(const IndirectBatch& batch, const Shader& shader)
+{
+    shader.Bind();
+    batch.Bind();
+
+    // One command per mesh, instance counts were written by the cull shader
+    GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, batch.GetMeshCount(), 0));
+}
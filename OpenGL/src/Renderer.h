@@ -14,9 +14,15 @@ bool GLLogCall(const char* function, const char* file, int line);
 
 //====================================================================
 
+class IndirectBatch;
+
 class Renderer
 {
 public:
     void Clear() const;
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader);
+    // Draws only the first count indices of the index buffer
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count);
+    // Draws every visible instance in the batch. Call IndirectBatch::Cull first
+    void DrawIndirect(const IndirectBatch& batch, const Shader& shader);
 };
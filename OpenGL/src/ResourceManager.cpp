@@ -0,0 +1,273 @@
+#include "ResourceManager.h"
+#include "Renderer.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+// Lexically normalises a path so every spelling of the same file gets one
+// key: "res\\textures\\a.png", "./res/textures/a.png" and
+// "res/shaders/../textures/./a.png" all become "res/textures/a.png". Only
+// the string is looked at, symlinks and different absolute/relative
+// spellings of one file still load twice
+static std::string NormalizePath(const std::string& path)
+{
+	std::string unified = path;
+	std::replace(unified.begin(), unified.end(), '\\', '/');
+#ifdef _WIN32
+	// Windows paths are case insensitive
+	std::transform(unified.begin(), unified.end(), unified.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+#endif
+
+	bool absolute = !unified.empty() && unified[0] == '/';
+	std::vector<std::string> segments;
+	size_t start = 0;
+	while (start <= unified.size())
+	{
+		size_t end = unified.find('/', start);
+		if (end == std::string::npos)
+			end = unified.size();
+		std::string segment = unified.substr(start, end - start);
+		start = end + 1;
+
+		if (segment.empty() || segment == "." || (segment == ".." && absolute && segments.empty()))
+			continue;
+		// ".." can only cancel a real directory, leading ones are kept
+		if (segment == ".." && !segments.empty() && segments.back() != "..")
+			segments.pop_back();
+		else
+			segments.push_back(segment);
+	}
+
+	std::string result = absolute ? "/" : "";
+	for (unsigned int i = 0; i < segments.size(); i++)
+	{
+		if (i > 0)
+			result += '/';
+		result += segments[i];
+	}
+	return result;
+}
+
+ResourceManager::ResourceManager(size_t textureBudgetBytes)
+	: m_Frame(1)
+	, m_TextureBudget(textureBudgetBytes)
+	, m_MemoryUsage{}
+	, m_EvictionCount(0)
+{
+}
+
+ResourceManager::~ResourceManager()
+{
+	for (const auto& slot : m_Textures.Slots)
+	{
+		if (slot.RefCount > 0)
+			std::cout << "Warning: texture '" << slot.Path << "' still referenced on shutdown" << std::endl;
+	}
+	for (const auto& slot : m_Shaders.Slots)
+	{
+		if (slot.RefCount > 0)
+			std::cout << "Warning: shader '" << slot.Path << "' still referenced on shutdown" << std::endl;
+	}
+}
+
+template<typename T>
+unsigned int ResourceManager::AllocateSlot(Pool<T>& pool, const std::string& path)
+{
+	unsigned int index;
+	if (!pool.FreeSlots.empty())
+	{
+		index = pool.FreeSlots.back();
+		pool.FreeSlots.pop_back();
+	}
+	else
+	{
+		index = (unsigned int)pool.Slots.size();
+		pool.Slots.emplace_back();
+	}
+
+	pool.Slots[index].Path = path;
+	pool.PathToSlot[path] = index;
+	return index;
+}
+
+template<typename T>
+ResourceManager::Slot<T>* ResourceManager::Resolve(Pool<T>& pool, ResourceHandle<T> handle)
+{
+	if (handle.Index >= pool.Slots.size())
+		return nullptr;
+
+	Slot<T>& slot = pool.Slots[handle.Index];
+	if (slot.Generation != handle.Generation || slot.RefCount == 0)
+		return nullptr;
+
+	return &slot;
+}
+
+// Returns true when the last reference was dropped and the slot freed
+template<typename T>
+bool ResourceManager::ReleaseSlot(Pool<T>& pool, ResourceHandle<T> handle)
+{
+	Slot<T>* slot = Resolve(pool, handle);
+	if (!slot)
+		return false;
+
+	if (--slot->RefCount > 0)
+		return false;
+
+	pool.PathToSlot.erase(slot->Path);
+	slot->Path.clear();
+	// Skip 0 on wrap around, it marks an invalid handle
+	if (++slot->Generation == 0)
+		slot->Generation = 1;
+	pool.FreeSlots.push_back(handle.Index);
+	return true;
+}
+
+//=============================================================================
+
+TextureHandle ResourceManager::LoadTexture(const std::string& path)
+{
+	std::string key = NormalizePath(path);
+
+	auto it = m_Textures.PathToSlot.find(key);
+	unsigned int index = it != m_Textures.PathToSlot.end() ? it->second : AllocateSlot(m_Textures, key);
+
+	Slot<Texture>& slot = m_Textures.Slots[index];
+	if (!slot.Resource)
+		LoadTextureSlot(slot);
+	slot.RefCount++;
+	slot.LastUsedFrame = m_Frame;
+
+	return { index, slot.Generation };
+}
+
+ShaderHandle ResourceManager::LoadShader(const std::string& path)
+{
+	std::string key = NormalizePath(path);
+
+	auto it = m_Shaders.PathToSlot.find(key);
+	unsigned int index = it != m_Shaders.PathToSlot.end() ? it->second : AllocateSlot(m_Shaders, key);
+
+	Slot<Shader>& slot = m_Shaders.Slots[index];
+	if (!slot.Resource)
+	{
+		slot.Resource = std::make_unique<Shader>(key);
+		slot.Bytes = slot.Resource->GetProgramSize();
+		m_MemoryUsage[(int)ResourceType::Shader] += slot.Bytes;
+	}
+	slot.RefCount++;
+	slot.LastUsedFrame = m_Frame;
+
+	return { index, slot.Generation };
+}
+
+void ResourceManager::Release(TextureHandle handle)
+{
+	Slot<Texture>* slot = Resolve(m_Textures, handle);
+	if (slot && slot->RefCount == 1)
+		UnloadTextureSlot(*slot);
+	ReleaseSlot(m_Textures, handle);
+}
+
+void ResourceManager::Release(ShaderHandle handle)
+{
+	Slot<Shader>* slot = Resolve(m_Shaders, handle);
+	if (slot && slot->RefCount == 1)
+	{
+		m_MemoryUsage[(int)ResourceType::Shader] -= slot->Bytes;
+		slot->Bytes = 0;
+		slot->Resource.reset();
+	}
+	ReleaseSlot(m_Shaders, handle);
+}
+
+Texture* ResourceManager::Get(TextureHandle handle)
+{
+	Slot<Texture>* slot = Resolve(m_Textures, handle);
+	if (!slot)
+		return nullptr;
+
+	if (!slot->Resource)
+		LoadTextureSlot(*slot);
+	slot->LastUsedFrame = m_Frame;
+	return slot->Resource.get();
+}
+
+Shader* ResourceManager::Get(ShaderHandle handle)
+{
+	Slot<Shader>* slot = Resolve(m_Shaders, handle);
+	if (!slot)
+		return nullptr;
+
+	slot->LastUsedFrame = m_Frame;
+	return slot->Resource.get();
+}
+
+void ResourceManager::NewFrame()
+{
+	EnforceTextureBudget();
+	m_Frame++;
+}
+
+void ResourceManager::SetTextureBudget(size_t bytes)
+{
+	m_TextureBudget = bytes;
+}
+
+unsigned int ResourceManager::GetLoadedCount(ResourceType type) const
+{
+	unsigned int count = 0;
+	if (type == ResourceType::Texture)
+	{
+		for (const auto& slot : m_Textures.Slots)
+			count += slot.Resource ? 1 : 0;
+	}
+	else if (type == ResourceType::Shader)
+	{
+		for (const auto& slot : m_Shaders.Slots)
+			count += slot.Resource ? 1 : 0;
+	}
+	return count;
+}
+
+void ResourceManager::EnforceTextureBudget()
+{
+	size_t& usage = m_MemoryUsage[(int)ResourceType::Texture];
+	if (usage <= m_TextureBudget)
+		return;
+
+	// Textures used this frame may still be bound, leave them alone even
+	// if that means staying over budget until next frame
+	std::vector<Slot<Texture>*> candidates;
+	for (auto& slot : m_Textures.Slots)
+	{
+		if (slot.Resource && slot.LastUsedFrame < m_Frame)
+			candidates.push_back(&slot);
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const Slot<Texture>* a, const Slot<Texture>* b)
+	{
+		return a->LastUsedFrame < b->LastUsedFrame;
+	});
+
+	for (Slot<Texture>* slot : candidates)
+	{
+		if (usage <= m_TextureBudget)
+			break;
+		UnloadTextureSlot(*slot);
+		m_EvictionCount++;
+	}
+}
+
+void ResourceManager::LoadTextureSlot(Slot<Texture>& slot)
+{
+	slot.Resource = std::make_unique<Texture>(slot.Path);
+	slot.Bytes = slot.Resource->GetSizeInBytes();
+	m_MemoryUsage[(int)ResourceType::Texture] += slot.Bytes;
+}
+
+void ResourceManager::UnloadTextureSlot(Slot<Texture>& slot)
+{
+	m_MemoryUsage[(int)ResourceType::Texture] -= slot.Bytes;
+	slot.Bytes = 0;
+	slot.Resource.reset();
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "Texture.h"
+#include "Shader.h"
+
+// A handle stays valid until the resource is released, then the slot's
+// generation changes and the stale handle resolves to nullptr instead of
+// whatever got loaded into the slot next
+template<typename T>
+struct ResourceHandle
+{
+	unsigned int Index = 0;
+	unsigned int Generation = 0; // 0 is never a live generation
+
+	inline bool operator==(const ResourceHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+	inline bool operator!=(const ResourceHandle& other) const { return !(*this == other); }
+};
+
+typedef ResourceHandle<Texture> TextureHandle;
+typedef ResourceHandle<Shader> ShaderHandle;
+
+enum class ResourceType
+{
+	Texture = 0,
+	Shader = 1,
+	Count,
+};
+
+// Loads textures and shaders once per file path and hands out handles to
+// them. Estimated GPU memory is tracked per resource type, and when the
+// textures go over budget the least recently used ones are unloaded, to
+// be reloaded from disk the next time their handle is resolved.
+class ResourceManager
+{
+private:
+	template<typename T>
+	struct Slot
+	{
+		std::unique_ptr<T> Resource; // null while free or evicted
+		std::string Path;
+		unsigned int Generation = 1;
+		unsigned int RefCount = 0;
+		unsigned long long LastUsedFrame = 0;
+		unsigned int Bytes = 0;
+	};
+
+	template<typename T>
+	struct Pool
+	{
+		std::vector<Slot<T>> Slots;
+		std::vector<unsigned int> FreeSlots;
+		std::unordered_map<std::string, unsigned int> PathToSlot;
+	};
+
+	Pool<Texture> m_Textures;
+	Pool<Shader> m_Shaders;
+
+	unsigned long long m_Frame;
+	size_t m_TextureBudget;
+	size_t m_MemoryUsage[(int)ResourceType::Count];
+	unsigned int m_EvictionCount;
+
+public:
+	ResourceManager(size_t textureBudgetBytes = 256 * 1024 * 1024);
+	~ResourceManager();
+
+	// Loading a path that is already loaded returns the existing handle
+	// and adds a reference, every Load needs a matching Release. Paths are
+	// compared after resolving "." and ".." and unifying slashes (and case
+	// on Windows), the file system isn't consulted
+	TextureHandle LoadTexture(const std::string& path);
+	ShaderHandle LoadShader(const std::string& path);
+
+	void Release(TextureHandle handle);
+	void Release(ShaderHandle handle);
+
+	// nullptr for stale handles. Evicted textures are reloaded here. The
+	// pointer is only valid until the next NewFrame, which may evict the
+	// texture, so resolve the handle again each frame instead of keeping it
+	Texture* Get(TextureHandle handle);
+	Shader* Get(ShaderHandle handle);
+
+	// Call once per frame. Evicts least recently used textures that weren't
+	// used this frame until texture memory is back under budget
+	void NewFrame();
+
+	void SetTextureBudget(size_t bytes);
+	inline size_t GetMemoryUsage(ResourceType type) const { return m_MemoryUsage[(int)type]; }
+	inline unsigned int GetEvictionCount() const { return m_EvictionCount; }
+	unsigned int GetLoadedCount(ResourceType type) const;
+
+private:
+	void EnforceTextureBudget();
+	void LoadTextureSlot(Slot<Texture>& slot);
+	void UnloadTextureSlot(Slot<Texture>& slot);
+
+	template<typename T>
+	unsigned int AllocateSlot(Pool<T>& pool, const std::string& path);
+	template<typename T>
+	Slot<T>* Resolve(Pool<T>& pool, ResourceHandle<T> handle);
+	template<typename T>
+	bool ReleaseSlot(Pool<T>& pool, ResourceHandle<T> handle);
+};
@@ -1,5 +1,6 @@
 #include "Shader.h"
 #include "Renderer.h"
+#include "DeletionQueue.h"
 
 #include <iostream>
 #include <fstream>
@@ -14,11 +15,44 @@ Shader::Shader(const std::string& filepath)
     ShaderProgramSource source = ParseShader(m_Filepath);
     //std::cout << "VERTEX" << std::endl << source.VertexSource << std::endl;
     //std::cout << "FRAGMENT" << std::endl << source.FragmentSource << std::endl;
-    m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
+    // A file containing a '#shader compute' section builds a compute program
+    // instead of a vertex/fragment pair
+    if (!source.ComputeSource.empty())
+        m_RendererID = CreateComputeShader(source.ComputeSource);
+    else
+        m_RendererID = CreateShader(source.VertexSource, source.FragmentSource);
 }
+Shader::Shader(const std::string& filepath, const std::vector<std::string>& feedbackVaryings)
+	: m_Filepath(filepath), m_RendererID(0)
+{
+    ShaderProgramSource source = ParseShader(m_Filepath);
+    m_RendererID = CreateFeedbackShader(source.VertexSource, feedbackVaryings);
+}
+
 Shader::~Shader()
 {
-    GLCall(glDeleteProgram(m_RendererID));
+    DeletionQueue::Enqueue(GLObjectType::Program, m_RendererID);
+}
+
+Shader::Shader(Shader&& other) noexcept
+    : m_Filepath(std::move(other.m_Filepath))
+    , m_RendererID(other.m_RendererID)
+    , m_UniformLocationCache(std::move(other.m_UniformLocationCache))
+{
+    other.m_RendererID = 0;
+}
+
+Shader& Shader::operator=(Shader&& other)
+{
+    if (this != &other)
+    {
+        DeletionQueue::Enqueue(GLObjectType::Program, m_RendererID);
+        m_Filepath = std::move(other.m_Filepath);
+        m_RendererID = other.m_RendererID;
+        m_UniformLocationCache = std::move(other.m_UniformLocationCache);
+        other.m_RendererID = 0;
+    }
+    return *this;
 }
 
 ShaderProgramSource Shader::ParseShader(const std::string& filepath)
@@ -30,10 +64,11 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
         NONE = -1,
         VERTEX = 0,
         FRAGMENT = 1,
+        COMPUTE = 2,
     };
 
     std::string line;
-    std::stringstream ss[2];
+    std::stringstream ss[3];
     ShaderType type = ShaderType::NONE;
     while (getline(stream, line))
     {
@@ -43,13 +78,15 @@ ShaderProgramSource Shader::ParseShader(const std::string& filepath)
                 type = ShaderType::VERTEX;
             else if (line.find("fragment") != std::string::npos)
                 type = ShaderType::FRAGMENT;
+            else if (line.find("compute") != std::string::npos)
+                type = ShaderType::COMPUTE;
         }
         else if (type != ShaderType::NONE)
         {
             ss[(int)type] << line << '\n';
         }
     }
-    return { ss[0].str(), ss[1].str() };
+    return { ss[0].str(), ss[1].str(), ss[2].str() };
 }
 
 unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
@@ -74,7 +111,7 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
         char* message = (char*)alloca(length * sizeof(char));
         // retrieve log message
         GLCall(glGetShaderInfoLog(id, length, &length, message));
-        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment") << " shader!" << std::endl;
+        std::cout << "Failed to compile " << (type == GL_VERTEX_SHADER ? "Vertex" : type == GL_FRAGMENT_SHADER ? "Fragment" : "Compute") << " shader!" << std::endl;
         std::cout << message << std::endl;
         // cleanup before exiting function
         GLCall(glDeleteShader(id));
@@ -110,6 +147,43 @@ unsigned int Shader::CreateShader(const std::string& vertexShader, const std::st
     return program;
 }
 
+unsigned int Shader::CreateComputeShader(const std::string& computeShader)
+{
+    // Compute programs have a single stage and need GL 4.3
+    GLCall(unsigned int program = glCreateProgram());
+
+    unsigned int cs = CompileShader(GL_COMPUTE_SHADER, computeShader);
+
+    GLCall(glAttachShader(program, cs));
+    GLCall(glLinkProgram(program));
+    GLCall(glValidateProgram(program));
+
+    GLCall(glDeleteShader(cs));
+
+    return program;
+}
+
+unsigned int Shader::CreateFeedbackShader(const std::string& vertexShader, const std::vector<std::string>& feedbackVaryings)
+{
+    GLCall(unsigned int program = glCreateProgram());
+
+    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
+    GLCall(glAttachShader(program, vs));
+
+    // has to be set before linking
+    std::vector<const char*> varyings;
+    for (const auto& varying : feedbackVaryings)
+        varyings.push_back(varying.c_str());
+    GLCall(glTransformFeedbackVaryings(program, (int)varyings.size(), varyings.data(), GL_INTERLEAVED_ATTRIBS));
+
+    GLCall(glLinkProgram(program));
+    GLCall(glValidateProgram(program));
+
+    GLCall(glDeleteShader(vs));
+
+    return program;
+}
+
 void Shader::Bind() const
 {
     GLCall(glUseProgram(m_RendererID));
@@ -119,15 +193,46 @@ void Shader::Unbind() const
     GLCall(glUseProgram(0));
 }
 
+unsigned int Shader::GetProgramSize() const
+{
+    // GL_PROGRAM_BINARY_LENGTH is core since 4.1
+    if (!GLEW_VERSION_4_1)
+        return 0;
+
+    int length = 0;
+    GLCall(glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &length));
+    return (unsigned int)length;
+}
+
 // Set uniforms
 void Shader::SetUniform1i(const std::string& name, int value)
 {
     GLCall(glUniform1i(GetUniformLocation(name), value));
 }
+void Shader::SetUniform1f(const std::string& name, float value)
+{
+    GLCall(glUniform1f(GetUniformLocation(name), value));
+}
+void Shader::SetUniform1ui(const std::string& name, unsigned int value)
+{
+    GLCall(glUniform1ui(GetUniformLocation(name), value));
+}
+void Shader::SetUniform2f(const std::string& name, float v0, float v1)
+{
+    GLCall(glUniform2f(GetUniformLocation(name), v0, v1));
+}
+void Shader::SetUniform3f(const std::string& name, float v0, float v1, float v2)
+{
+    GLCall(glUniform3f(GetUniformLocation(name), v0, v1, v2));
+}
 void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
 {
     GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
 }
+void Shader::SetUniform4fv(const std::string& name, unsigned int count, const glm::vec4* values)
+{
+    GLCall(glUniform4fv(GetUniformLocation(name), count, &values[0][0]));
+}
 void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
 {
     GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
@@ -1,12 +1,14 @@
 #pragma once
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "glm/glm.hpp"
 
 struct ShaderProgramSource
 {
 	std::string VertexSource;
 	std::string FragmentSource;
+	std::string ComputeSource;
 };
 
 class Shader
@@ -18,14 +20,30 @@ private:
 
 public:
 	Shader(const std::string& filepath);
+	// Vertex only program whose outputs are captured with transform feedback,
+	// interleaved in the order given
+	Shader(const std::string& filepath, const std::vector<std::string>& feedbackVaryings);
 	~Shader();
 
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+	Shader(Shader&& other) noexcept;
+	Shader& operator=(Shader&& other);
+
 	void Bind() const;
 	void Unbind() const;
 
+	// Size of the linked program binary, or 0 when the driver can't report it
+	unsigned int GetProgramSize() const;
+
 	// Set uniforms
 	void SetUniform1i(const std::string& name, int value);
+	void SetUniform1f(const std::string& name, float value);
+	void SetUniform1ui(const std::string& name, unsigned int value);
+	void SetUniform2f(const std::string& name, float v0, float v1);
+	void SetUniform3f(const std::string& name, float v0, float v1, float v2);
 	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
+	void SetUniform4fv(const std::string& name, unsigned int count, const glm::vec4* values);
 	void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
 
 private:
@@ -34,5 +52,7 @@ private:
 	ShaderProgramSource ParseShader(const std::string& filepath);
 	unsigned int CompileShader(unsigned int type, const std::string& source);
 	unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
+	unsigned int CreateComputeShader(const std::string& computeShader);
+	unsigned int CreateFeedbackShader(const std::string& vertexShader, const std::vector<std::string>& feedbackVaryings);
 };
 
@@ -0,0 +1,132 @@
+#include "StreamBuffer.h"
+#include "Renderer.h"
+#include "DeletionQueue.h"
+
+// Note that for GL_ELEMENT_ARRAY_BUFFER every bind below lands in the bound
+// vertex array, so bind the one that should own the index buffer first
+
+// Keeps region offsets valid for any index or vertex attribute type
+static const unsigned int REGION_ALIGNMENT = 256;
+
+StreamBuffer::StreamBuffer(unsigned int target, unsigned int regionSize, unsigned int regionCount)
+	: m_RendererID(0)
+	, m_Target(target)
+	, m_RegionSize(0)
+	, m_RegionCount(regionCount)
+	, m_Region(0)
+	, m_Fences(regionCount, nullptr)
+	, m_PersistentData(nullptr)
+	, m_Mapped(false)
+{
+	Allocate(regionSize);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	Release();
+}
+
+void StreamBuffer::Allocate(unsigned int regionSize)
+{
+	m_RegionSize = (regionSize + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT * REGION_ALIGNMENT;
+	m_Region = m_RegionCount - 1; // so the first Map lands on region 0
+	unsigned int totalSize = m_RegionSize * m_RegionCount;
+
+	GLCall(glGenBuffers(1, &m_RendererID));
+	GLCall(glBindBuffer(m_Target, m_RendererID));
+	if (GLEW_ARB_buffer_storage)
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		GLCall(glBufferStorage(m_Target, totalSize, nullptr, flags));
+		GLCall(m_PersistentData = (unsigned char*)glMapBufferRange(m_Target, 0, totalSize, flags));
+	}
+	else
+	{
+		GLCall(glBufferData(m_Target, totalSize, nullptr, GL_STREAM_DRAW));
+	}
+}
+
+void StreamBuffer::Release()
+{
+	for (auto& fence : m_Fences)
+	{
+		if (fence)
+		{
+			GLCall(glDeleteSync((GLsync)fence));
+			fence = nullptr;
+		}
+	}
+
+	if (m_PersistentData)
+	{
+		GLCall(glBindBuffer(m_Target, m_RendererID));
+		GLCall(glUnmapBuffer(m_Target));
+		m_PersistentData = nullptr;
+	}
+
+	// The GPU may still be reading the old regions
+	DeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+	m_RendererID = 0;
+}
+
+void* StreamBuffer::Map(unsigned int size)
+{
+	ASSERT(!m_Mapped);
+
+	if (size > m_RegionSize)
+	{
+		Release();
+		Allocate(size + size / 2);
+	}
+
+	m_Region = (m_Region + 1) % m_RegionCount;
+
+	GLsync fence = (GLsync)m_Fences[m_Region];
+	if (fence)
+	{
+		// Normally signalled long ago, only blocks when the GPU is a whole ring behind
+		GLenum status = GL_TIMEOUT_EXPIRED;
+		while (status == GL_TIMEOUT_EXPIRED)
+		{
+			GLCall(status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000));
+		}
+		GLCall(glDeleteSync(fence));
+		m_Fences[m_Region] = nullptr;
+	}
+
+	m_Mapped = true;
+	if (m_PersistentData)
+		return m_PersistentData + GetOffset();
+
+	GLCall(glBindBuffer(m_Target, m_RendererID));
+	GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+	GLCall(void* data = glMapBufferRange(m_Target, GetOffset(), size, access));
+	return data;
+}
+
+void StreamBuffer::Unmap()
+{
+	ASSERT(m_Mapped);
+	m_Mapped = false;
+
+	// Coherent persistent mappings need no unmap or flush
+	if (m_PersistentData)
+		return;
+
+	GLCall(glBindBuffer(m_Target, m_RendererID));
+	GLCall(glUnmapBuffer(m_Target));
+}
+
+void StreamBuffer::Fence()
+{
+	if (m_Fences[m_Region])
+	{
+		GLCall(glDeleteSync((GLsync)m_Fences[m_Region]));
+	}
+	GLCall(m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+void StreamBuffer::Bind() const
+{
+	GLCall(glBindBuffer(m_Target, m_RendererID));
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+
+// A buffer split into regions that are written round robin, one region per
+// frame, so the CPU fills one region while the GPU still reads the others.
+// Each region is fenced after use and only waited on when the ring wraps
+// around to it. With GL 4.4 the buffer stays persistently mapped, otherwise
+// regions are mapped unsynchronized each frame (the fences keep that safe).
+class StreamBuffer
+{
+private:
+	unsigned int m_RendererID;
+	unsigned int m_Target;
+	unsigned int m_RegionSize;
+	unsigned int m_RegionCount;
+	unsigned int m_Region;
+	std::vector<void*> m_Fences; // GLsync per region
+	unsigned char* m_PersistentData;
+	bool m_Mapped;
+
+public:
+	StreamBuffer(unsigned int target, unsigned int regionSize, unsigned int regionCount = 3);
+	~StreamBuffer();
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	// Moves to the next region and returns it for writing. Grows the buffer
+	// (changing its renderer id) when size doesn't fit in a region
+	void* Map(unsigned int size);
+	void Unmap();
+	// Call after submitting the draws that read the current region. Can be
+	// called again for later draws reading the same region without remapping
+	void Fence();
+
+	void Bind() const;
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	// Byte offset of the current region
+	inline unsigned int GetOffset() const { return m_Region * m_RegionSize; }
+
+private:
+	void Allocate(unsigned int regionSize);
+	void Release();
+};
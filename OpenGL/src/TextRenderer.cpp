@@ -0,0 +1,300 @@
+#include "TextRenderer.h"
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "GLStateCache.h"
+#include <algorithm>
+#include <iostream>
+
+static std::vector<unsigned int> GenerateQuadIndices(unsigned int quadCount)
+{
+	std::vector<unsigned int> indices(quadCount * 6);
+	for (unsigned int i = 0; i < quadCount; i++)
+	{
+		indices[i * 6 + 0] = i * 4 + 0;
+		indices[i * 6 + 1] = i * 4 + 1;
+		indices[i * 6 + 2] = i * 4 + 2;
+		indices[i * 6 + 3] = i * 4 + 2;
+		indices[i * 6 + 4] = i * 4 + 3;
+		indices[i * 6 + 5] = i * 4 + 0;
+	}
+	return indices;
+}
+
+TextRenderer::TextRenderer(const Font& font, unsigned int maxGlyphs)
+	: m_Font(font)
+	, m_Shader("res/shaders/Text.shader")
+	, m_VertexBuffer(nullptr, maxGlyphs * 4 * sizeof(TextVertex), GL_DYNAMIC_DRAW)
+	, m_IndexBuffer(GenerateQuadIndices(maxGlyphs).data(), maxGlyphs * 6)
+	, m_Vertices(maxGlyphs * 4, TextVertex{})
+	, m_MaxGlyphs(maxGlyphs)
+	, m_UsedGlyphs(0)
+	, m_DirtyBegin(maxGlyphs)
+	, m_DirtyEnd(0)
+	, m_LayoutCount(0)
+{
+	VertexBufferLayout layout;
+	layout.Push<float>(2);
+	layout.Push<float>(2);
+	layout.Push<unsigned char>(4);
+	m_VertexArray.AddBuffer(m_VertexBuffer, layout);
+	m_VertexArray.Unbind();
+
+	m_Shader.Bind();
+	m_Shader.SetUniform1i("u_Atlas", 0);
+}
+
+TextRenderer::~TextRenderer()
+{
+}
+
+unsigned int TextRenderer::AddText(const std::string& text, const glm::vec2& position, float size, const glm::vec4& color)
+{
+	unsigned int id;
+	if (!m_FreeRuns.empty())
+	{
+		id = m_FreeRuns.back();
+		m_FreeRuns.pop_back();
+	}
+	else
+	{
+		id = (unsigned int)m_Runs.size();
+		m_Runs.emplace_back();
+	}
+
+	TextRun& run = m_Runs[id];
+	run.Position = position;
+	run.Size = size;
+	run.Color = color;
+	run.FirstGlyph = 0;
+	run.Capacity = 0;
+	run.Alive = true;
+	Layout(run, text);
+	Place(run);
+	return id;
+}
+
+void TextRenderer::RemoveText(unsigned int id)
+{
+	TextRun& run = m_Runs[id];
+	ASSERT(run.Alive);
+
+	Free(run);
+	run.Layout.clear();
+	run.Alive = false;
+	m_FreeRuns.push_back(id);
+}
+
+void TextRenderer::SetText(unsigned int id, const std::string& text)
+{
+	TextRun& run = m_Runs[id];
+	ASSERT(run.Alive);
+
+	Layout(run, text);
+	Place(run);
+}
+
+void TextRenderer::SetSize(unsigned int id, float size)
+{
+	TextRun& run = m_Runs[id];
+	ASSERT(run.Alive);
+
+	// The layout is stored at size 1, so this is only a re-place
+	run.Size = size;
+	Place(run);
+}
+
+void TextRenderer::SetPosition(unsigned int id, const glm::vec2& position)
+{
+	TextRun& run = m_Runs[id];
+	ASSERT(run.Alive);
+
+	run.Position = position;
+	Place(run);
+}
+
+void TextRenderer::SetColor(unsigned int id, const glm::vec4& color)
+{
+	TextRun& run = m_Runs[id];
+	ASSERT(run.Alive);
+
+	run.Color = color;
+	Place(run);
+}
+
+void TextRenderer::Layout(TextRun& run, const std::string& text)
+{
+	m_LayoutCount++;
+	run.Layout.clear();
+	if (!m_Font.IsLoaded())
+		return;
+
+	// Laid out at a line height of 1, scaled by the run's size when placed
+	const float scale = 1.0f / m_Font.GetLineHeight();
+	glm::vec2 pen(0.0f, 0.0f);
+	int previous = 0;
+	for (unsigned char c : text)
+	{
+		if (c == '\n')
+		{
+			pen.x = 0.0f;
+			pen.y -= 1.0f;
+			previous = 0;
+			continue;
+		}
+
+		const Glyph* glyph = m_Font.GetGlyph(c);
+		if (!glyph)
+			glyph = m_Font.GetGlyph('?');
+		if (!glyph)
+			continue;
+
+		if (previous)
+			pen.x += m_Font.GetKerning(previous, c) * scale;
+		previous = c;
+
+		if (glyph->Size.x > 0.0f)
+		{
+			LocalQuad quad;
+			quad.Min = glm::vec2(pen.x + glyph->Offset.x * scale, pen.y + (glyph->Offset.y - glyph->Size.y) * scale);
+			quad.Max = glm::vec2(pen.x + (glyph->Offset.x + glyph->Size.x) * scale, pen.y + glyph->Offset.y * scale);
+			quad.UV0 = glyph->UV0;
+			quad.UV1 = glyph->UV1;
+			run.Layout.push_back(quad);
+		}
+		pen.x += glyph->Advance * scale;
+	}
+}
+
+void TextRenderer::Place(TextRun& run)
+{
+	unsigned int count = (unsigned int)run.Layout.size();
+	if (count > run.Capacity || count == 0)
+	{
+		Free(run);
+		if (count > 0 && !Allocate(run, count))
+		{
+			std::cout << "Warning: TextRenderer is out of glyphs" << std::endl;
+			return;
+		}
+	}
+
+	unsigned char color[4];
+	for (int i = 0; i < 4; i++)
+		color[i] = (unsigned char)(glm::clamp(run.Color[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+
+	TextVertex* v = &m_Vertices[run.FirstGlyph * 4];
+	for (const auto& quad : run.Layout)
+	{
+		glm::vec2 min = run.Position + quad.Min * run.Size;
+		glm::vec2 max = run.Position + quad.Max * run.Size;
+		// Atlas rows go top to bottom, UV0 is the glyph's top left
+		v[0] = { { min.x, min.y }, { quad.UV0.x, quad.UV1.y }, { color[0], color[1], color[2], color[3] } };
+		v[1] = { { max.x, min.y }, { quad.UV1.x, quad.UV1.y }, { color[0], color[1], color[2], color[3] } };
+		v[2] = { { max.x, max.y }, { quad.UV1.x, quad.UV0.y }, { color[0], color[1], color[2], color[3] } };
+		v[3] = { { min.x, max.y }, { quad.UV0.x, quad.UV0.y }, { color[0], color[1], color[2], color[3] } };
+		v += 4;
+	}
+	// Leftover capacity from a longer string is collapsed to nothing
+	for (unsigned int i = count; i < run.Capacity; i++, v += 4)
+		v[0] = v[1] = v[2] = v[3] = TextVertex{};
+
+	MarkDirty(run.FirstGlyph, run.Capacity);
+}
+
+bool TextRenderer::Allocate(TextRun& run, unsigned int count)
+{
+	// Lowest first fit from the freed ranges, otherwise grow the used region
+	for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+	{
+		if (it->Count < count)
+			continue;
+
+		run.FirstGlyph = it->First;
+		run.Capacity = count;
+		it->First += count;
+		it->Count -= count;
+		if (it->Count == 0)
+			m_FreeRanges.erase(it);
+		return true;
+	}
+
+	if (m_UsedGlyphs + count > m_MaxGlyphs)
+		return false;
+
+	run.FirstGlyph = m_UsedGlyphs;
+	run.Capacity = count;
+	m_UsedGlyphs += count;
+	return true;
+}
+
+void TextRenderer::Free(TextRun& run)
+{
+	if (run.Capacity == 0)
+		return;
+
+	std::fill(m_Vertices.begin() + run.FirstGlyph * 4, m_Vertices.begin() + (run.FirstGlyph + run.Capacity) * 4, TextVertex{});
+	MarkDirty(run.FirstGlyph, run.Capacity);
+
+	// Merge with the free neighbours so the hole can take a longer string
+	// later, and hand a range at the end back so the draw covers less
+	GlyphRange range = { run.FirstGlyph, run.Capacity };
+	auto next = std::lower_bound(m_FreeRanges.begin(), m_FreeRanges.end(), range.First,
+		[](const GlyphRange& free, unsigned int first) { return free.First < first; });
+	if (next != m_FreeRanges.end() && range.First + range.Count == next->First)
+	{
+		range.Count += next->Count;
+		next = m_FreeRanges.erase(next);
+	}
+	if (next != m_FreeRanges.begin() && (next - 1)->First + (next - 1)->Count == range.First)
+	{
+		range.First = (next - 1)->First;
+		range.Count += (next - 1)->Count;
+		next = m_FreeRanges.erase(next - 1);
+	}
+
+	if (range.First + range.Count == m_UsedGlyphs)
+		m_UsedGlyphs = range.First;
+	else
+		m_FreeRanges.insert(next, range);
+
+	run.FirstGlyph = 0;
+	run.Capacity = 0;
+}
+
+void TextRenderer::MarkDirty(unsigned int first, unsigned int count)
+{
+	// An empty run would otherwise stretch the range down to its slot
+	if (count == 0)
+		return;
+	m_DirtyBegin = std::min(m_DirtyBegin, first);
+	m_DirtyEnd = std::max(m_DirtyEnd, first + count);
+}
+
+void TextRenderer::Render(const glm::mat4& viewProjection)
+{
+	if (m_DirtyBegin < m_DirtyEnd)
+	{
+		m_VertexBuffer.Bind();
+		GLCall(glBufferSubData(GL_ARRAY_BUFFER, m_DirtyBegin * 4 * sizeof(TextVertex),
+			(m_DirtyEnd - m_DirtyBegin) * 4 * sizeof(TextVertex), &m_Vertices[m_DirtyBegin * 4]));
+		m_DirtyBegin = m_MaxGlyphs;
+		m_DirtyEnd = 0;
+	}
+
+	if (m_UsedGlyphs == 0 || !m_Font.IsLoaded())
+		return;
+
+	GLStateCache::State previous = GLStateCache::Get();
+	GLStateCache::SetBlend(true);
+	GLStateCache::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	m_Font.GetAtlas().Bind();
+	m_Shader.Bind();
+	m_Shader.SetUniformMat4f("u_ViewProjection", viewProjection);
+
+	Renderer renderer;
+	renderer.Draw(m_VertexArray, m_IndexBuffer, m_Shader, m_UsedGlyphs * 6);
+	m_VertexArray.Unbind();
+
+	GLStateCache::Apply(previous);
+}
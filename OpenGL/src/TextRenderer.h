@@ -0,0 +1,95 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "Font.h"
+
+struct TextVertex
+{
+	glm::vec2 Position;
+	glm::vec2 TexCoord;
+	unsigned char Color[4];
+};
+
+// Draws any number of text runs in one font with a single draw call. A
+// run is laid out only when its string changes. The glyph quads are kept
+// at size 1, so resizing, moving or recolouring a run only re-places them
+// into its vertices, and runs that don't change cost nothing per frame.
+// Each run owns a range of glyph slots in one shared vertex buffer and
+// only modified ranges are uploaded.
+class TextRenderer
+{
+private:
+	struct LocalQuad
+	{
+		glm::vec2 Min, Max;     // relative to the run's position, at size 1
+		glm::vec2 UV0, UV1;
+	};
+
+	struct TextRun
+	{
+		std::vector<LocalQuad> Layout;
+		glm::vec2 Position;
+		float Size;
+		glm::vec4 Color;
+		unsigned int FirstGlyph;
+		unsigned int Capacity;
+		bool Alive;
+	};
+
+	struct GlyphRange
+	{
+		unsigned int First;
+		unsigned int Count;
+	};
+
+	const Font& m_Font;
+	Shader m_Shader;
+	VertexArray m_VertexArray;
+	VertexBuffer m_VertexBuffer;
+	IndexBuffer m_IndexBuffer;
+
+	std::vector<TextVertex> m_Vertices; // CPU copy, 4 per glyph slot
+	std::vector<TextRun> m_Runs;
+	std::vector<unsigned int> m_FreeRuns;
+	// Sorted by First with neighbours merged, and never touching m_UsedGlyphs
+	std::vector<GlyphRange> m_FreeRanges;
+	unsigned int m_MaxGlyphs;
+	unsigned int m_UsedGlyphs; // end of the last allocated range, the draw covers [0, m_UsedGlyphs)
+
+	// Glyph slots modified since the last upload
+	unsigned int m_DirtyBegin, m_DirtyEnd;
+	unsigned int m_LayoutCount;
+
+public:
+	TextRenderer(const Font& font, unsigned int maxGlyphs);
+	~TextRenderer();
+
+	// Returns an id for the other calls. size is the line height in pixels
+	unsigned int AddText(const std::string& text, const glm::vec2& position, float size, const glm::vec4& color);
+	void RemoveText(unsigned int id);
+
+	void SetText(unsigned int id, const std::string& text);
+	void SetSize(unsigned int id, float size);
+	void SetPosition(unsigned int id, const glm::vec2& position);
+	void SetColor(unsigned int id, const glm::vec4& color);
+
+	// Uploads modified ranges, then draws every run
+	void Render(const glm::mat4& viewProjection);
+
+	// Number of times a string has been laid out, for checking that layout is cached
+	inline unsigned int GetLayoutCount() const { return m_LayoutCount; }
+	inline unsigned int GetUsedGlyphs() const { return m_UsedGlyphs; }
+
+private:
+	void Layout(TextRun& run, const std::string& text);
+	void Place(TextRun& run);
+	bool Allocate(TextRun& run, unsigned int count);
+	void Free(TextRun& run);
+	void MarkDirty(unsigned int first, unsigned int count);
+};
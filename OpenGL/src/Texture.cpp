@@ -1,4 +1,5 @@
 #include "Texture.h"
+#include "DeletionQueue.h"
 #include "stb_image/stb_image.h"
 
 Texture::Texture(const std::string& path)
@@ -8,6 +9,7 @@ Texture::Texture(const std::string& path)
 	, m_Width(0)
 	, m_Height(0)
 	, m_BPP(0)
+	, m_Channels(4)
 {
 	stbi_set_flip_vertically_on_load(1);
 	m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
@@ -27,9 +29,69 @@ Texture::Texture(const std::string& path)
 		stbi_image_free(m_LocalBuffer);
 }
 
+Texture::Texture(int width, int height, int channels, const unsigned char* pixels)
+	: m_RendererID(0)
+	, m_LocalBuffer(nullptr)
+	, m_Width(width)
+	, m_Height(height)
+	, m_BPP(channels)
+	, m_Channels(channels)
+{
+	ASSERT(channels == 1 || channels == 4);
+
+	GLCall(glGenTextures(1, &m_RendererID));
+	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+	// Single channel rows aren't necessarily 4 byte aligned
+	GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+	if (channels == 1)
+	{
+		GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_Width, m_Height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels));
+	}
+	else
+	{
+		GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+	}
+	GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+	Unbind();
+}
+
 Texture::~Texture()
 {
-	GLCall(glDeleteTextures(1, &m_RendererID));
+	DeletionQueue::Enqueue(GLObjectType::Texture, m_RendererID);
+}
+
+Texture::Texture(Texture&& other) noexcept
+	: m_RendererID(other.m_RendererID)
+	, m_FilePath(std::move(other.m_FilePath))
+	, m_LocalBuffer(nullptr)
+	, m_Width(other.m_Width)
+	, m_Height(other.m_Height)
+	, m_BPP(other.m_BPP)
+	, m_Channels(other.m_Channels)
+{
+	other.m_RendererID = 0;
+}
+
+Texture& Texture::operator=(Texture&& other)
+{
+	if (this != &other)
+	{
+		DeletionQueue::Enqueue(GLObjectType::Texture, m_RendererID);
+		m_RendererID = other.m_RendererID;
+		m_FilePath = std::move(other.m_FilePath);
+		m_Width = other.m_Width;
+		m_Height = other.m_Height;
+		m_BPP = other.m_BPP;
+		m_Channels = other.m_Channels;
+		other.m_RendererID = 0;
+	}
+	return *this;
 }
 
 void Texture::Bind(unsigned int slot) const
@@ -8,15 +8,26 @@ private:
 	std::string m_FilePath;
 	unsigned char* m_LocalBuffer;
 	int m_Width, m_Height, m_BPP;
+	// Channels of the GL texture, 4 unless created from memory with fewer
+	int m_Channels;
 
 public:
 	Texture(const std::string& path);
+	// From memory, channels = 1 (GL_R8) or 4 (GL_RGBA8), rows tightly packed
+	Texture(int width, int height, int channels, const unsigned char* pixels);
 	~Texture();
 
+	Texture(const Texture&) = delete;
+	Texture& operator=(const Texture&) = delete;
+	Texture(Texture&& other) noexcept;
+	Texture& operator=(Texture&& other);
+
 	void Bind(unsigned int slot =  0) const;
 	void Unbind() const;
 
 	inline int GetWidth()  const { return m_Width; };
 	inline int GetHeight() const { return m_Height; };
+	// No mips, so just the base level
+	inline unsigned int GetSizeInBytes() const { return m_Width * m_Height * m_Channels; };
 };
 
@@ -1,5 +1,6 @@
 #include "VertexArray.h"
 #include "VertexBufferLayout.h"
+#include "DeletionQueue.h"
 
 
 VertexArray::VertexArray()
@@ -11,10 +12,27 @@ VertexArray::VertexArray()
 
 VertexArray::~VertexArray()
 {
-    GLCall(glDeleteVertexArrays(1, &m_RendererID));
+    DeletionQueue::Enqueue(GLObjectType::VertexArray, m_RendererID);
 }
 
-void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+VertexArray::VertexArray(VertexArray&& other) noexcept
+    : m_RendererID(other.m_RendererID)
+{
+    other.m_RendererID = 0;
+}
+
+VertexArray& VertexArray::operator=(VertexArray&& other)
+{
+    if (this != &other)
+    {
+        DeletionQueue::Enqueue(GLObjectType::VertexArray, m_RendererID);
+        m_RendererID = other.m_RendererID;
+        other.m_RendererID = 0;
+    }
+    return *this;
+}
+
+void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttribute, unsigned int divisor)
 {
     Bind();
 	vb.Bind();
@@ -24,10 +42,15 @@ void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& la
     for (unsigned int i = 0; i < elements.size(); i++)
     {
         const auto& element = elements[i];
+        unsigned int attribute = firstAttribute + i;
         // tell our GPU about the structure of our data (cols & rows)
-        GLCall(glEnableVertexAttribArray(i));
+        GLCall(glEnableVertexAttribArray(attribute));
         // links the vertex array to the currently bound vertex buffer
-        GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalised, layout.GetStride(), (const void*)offset));
+        GLCall(glVertexAttribPointer(attribute, element.count, element.type, element.normalised, layout.GetStride(), (const void*)offset));
+        if (divisor != 0)
+        {
+            GLCall(glVertexAttribDivisor(attribute, divisor));
+        }
         offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
     }
 }
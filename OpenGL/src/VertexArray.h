@@ -12,7 +12,14 @@ public:
 	VertexArray();
 	~VertexArray();
 
-	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+	VertexArray(const VertexArray&) = delete;
+	VertexArray& operator=(const VertexArray&) = delete;
+	VertexArray(VertexArray&& other) noexcept;
+	VertexArray& operator=(VertexArray&& other);
+
+	// Layout elements go to consecutive attributes starting at firstAttribute.
+	// A non zero divisor makes them per instance attributes
+	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout, unsigned int firstAttribute = 0, unsigned int divisor = 0);
 	void Bind() const;
 	void Unbind() const;
 };
\ No newline at end of file
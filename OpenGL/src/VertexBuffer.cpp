@@ -2,17 +2,35 @@
 #include "VertexBuffer.h"
 
 #include "Renderer.h"
+#include "DeletionQueue.h"
 
-VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+VertexBuffer::VertexBuffer(const void* data, unsigned int size, unsigned int usage)
 {
     GLCall(glGenBuffers(1, &m_RendererID));
     GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
-    GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, usage));
 }
 
 VertexBuffer::~VertexBuffer()
 {
-    GLCall(glDeleteBuffers(1, &m_RendererID));
+    DeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+}
+
+VertexBuffer::VertexBuffer(VertexBuffer&& other) noexcept
+    : m_RendererID(other.m_RendererID)
+{
+    other.m_RendererID = 0;
+}
+
+VertexBuffer& VertexBuffer::operator=(VertexBuffer&& other)
+{
+    if (this != &other)
+    {
+        DeletionQueue::Enqueue(GLObjectType::Buffer, m_RendererID);
+        m_RendererID = other.m_RendererID;
+        other.m_RendererID = 0;
+    }
+    return *this;
 }
 
 void VertexBuffer::Bind() const
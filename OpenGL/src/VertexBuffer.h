@@ -1,13 +1,22 @@
 #pragma once
+#include <GL/glew.h>
 
 class VertexBuffer
 {
 private:
 	unsigned int m_RendererID;
 public:
-	VertexBuffer(const void* data, unsigned int size);
+	// usage is a glBufferData hint, e.g. GL_DYNAMIC_COPY for buffers written by the GPU
+	VertexBuffer(const void* data, unsigned int size, unsigned int usage = GL_STATIC_DRAW);
 	~VertexBuffer();
 
+	VertexBuffer(const VertexBuffer&) = delete;
+	VertexBuffer& operator=(const VertexBuffer&) = delete;
+	VertexBuffer(VertexBuffer&& other) noexcept;
+	VertexBuffer& operator=(VertexBuffer&& other);
+
 	void Bind() const;
 	void Unbind() const;
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
 };
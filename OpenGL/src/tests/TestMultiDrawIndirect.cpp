@@ -0,0 +1,183 @@
+#include "TestMultiDrawIndirect.h"
+#include <GL/glew.h>
+#include <random>
+#include <iostream>
+#include "../Renderer.h"
+#include "../IndirectBatch.h"
+#include "../Shader.h"
+#include "../Texture.h"
+#include "imgui/imgui.h"
+#include "glm/gtc/matrix_transform.hpp"
+
+static const unsigned int INSTANCE_COUNT = 100000;
+static const float WORLD_WIDTH = 20000.0f;
+static const float WORLD_HEIGHT = 12000.0f;
+// World units a sphere can be off the plane by and still count either way,
+// float error at the far side of the world is around 0.002
+static const float CULL_CHECK_TOLERANCE = 0.05f;
+
+// Scatters the instances of three small meshes over the world, the same
+// scene every time
+static void BuildScene(IndirectBatch& batch)
+{
+	MeshVertex quad[] = {
+		{ { -10.0f, -10.0f, 0.0f }, { 0.0f, 0.0f } },
+		{ {  10.0f, -10.0f, 0.0f }, { 1.0f, 0.0f } },
+		{ {  10.0f,  10.0f, 0.0f }, { 1.0f, 1.0f } },
+		{ { -10.0f,  10.0f, 0.0f }, { 0.0f, 1.0f } },
+	};
+	unsigned int quadIndices[] = { 0, 1, 2, 2, 3, 0 };
+
+	MeshVertex triangle[] = {
+		{ { -10.0f, -10.0f, 0.0f }, { 0.0f, 0.0f } },
+		{ {  10.0f, -10.0f, 0.0f }, { 1.0f, 0.0f } },
+		{ {   0.0f,  10.0f, 0.0f }, { 0.5f, 1.0f } },
+	};
+	unsigned int triangleIndices[] = { 0, 1, 2 };
+
+	MeshVertex diamond[] = {
+		{ {   0.0f, -14.0f, 0.0f }, { 0.5f, 0.0f } },
+		{ {  10.0f,   0.0f, 0.0f }, { 1.0f, 0.5f } },
+		{ {   0.0f,  14.0f, 0.0f }, { 0.5f, 1.0f } },
+		{ { -10.0f,   0.0f, 0.0f }, { 0.0f, 0.5f } },
+	};
+	unsigned int diamondIndices[] = { 0, 1, 2, 2, 3, 0 };
+
+	unsigned int meshes[] = {
+		batch.AddMesh(quad, 4, quadIndices, 6),
+		batch.AddMesh(triangle, 3, triangleIndices, 3),
+		batch.AddMesh(diamond, 4, diamondIndices, 6),
+	};
+
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> x(0.0f, WORLD_WIDTH);
+	std::uniform_real_distribution<float> y(0.0f, WORLD_HEIGHT);
+	std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+	std::uniform_real_distribution<float> scale(0.5f, 1.5f);
+	for (unsigned int i = 0; i < INSTANCE_COUNT; i++)
+	{
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x(rng), y(rng), 0.0f));
+		model = glm::rotate(model, angle(rng), glm::vec3(0.0f, 0.0f, 1.0f));
+		model = glm::scale(model, glm::vec3(scale(rng)));
+		batch.AddInstance(meshes[i % 3], model);
+	}
+	batch.Build();
+}
+
+static glm::mat4 CameraViewProjection(const glm::mat4& proj, const glm::vec3& position, float zoom)
+{
+	glm::mat4 view = glm::scale(glm::mat4(1.0f), glm::vec3(zoom, zoom, 1.0f));
+	view = glm::translate(view, -position);
+	return proj * view;
+}
+
+test::TestMultiDrawIndirect::TestMultiDrawIndirect()
+	: m_Proj(glm::ortho<float>(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f))
+	, m_CameraPosition(0.0f, 0.0f, 0.0f)
+	, m_Zoom(1.0f)
+	, m_FrustumCulling(true)
+{
+	if (!IndirectBatch::IsSupported())
+		return;
+
+	m_Batch = std::make_unique<IndirectBatch>();
+	BuildScene(*m_Batch);
+
+	m_CullShader = std::make_unique<Shader>("res/shaders/Cull.shader");
+	m_Shader = std::make_unique<Shader>("res/shaders/Indirect.shader");
+	m_Texture = std::make_unique<Texture>("res/textures/ChernoLogo.png");
+
+	m_Shader->Bind();
+	m_Shader->SetUniform1i("u_Texture", 0);
+}
+
+test::TestMultiDrawIndirect::~TestMultiDrawIndirect()
+{
+}
+
+void test::TestMultiDrawIndirect::OnUpdate(float deltaTime) {}
+
+void test::TestMultiDrawIndirect::OnRender()
+{
+	if (!m_Batch)
+		return;
+
+	glm::mat4 viewProjection = CameraViewProjection(m_Proj, m_CameraPosition, m_Zoom);
+
+	Renderer renderer;
+	m_Batch->Cull(*m_CullShader, viewProjection, m_FrustumCulling);
+
+	m_Texture->Bind();
+	m_Shader->Bind();
+	m_Shader->SetUniformMat4f("u_ViewProjection", viewProjection);
+	renderer.DrawIndirect(*m_Batch, *m_Shader);
+}
+
+void test::TestMultiDrawIndirect::OnImGuiRender()
+{
+	if (!m_Batch)
+	{
+		ImGui::Text("Requires OpenGL 4.3 with vertex shader storage blocks");
+		return;
+	}
+
+	ImGui::SliderFloat2("Camera", &m_CameraPosition.x, 0.0f, WORLD_WIDTH);
+	ImGui::SliderFloat("Zoom", &m_Zoom, 0.02f, 2.0f);
+	ImGui::Checkbox("Frustum culling", &m_FrustumCulling);
+	ImGui::Text("%u meshes, %u instances, 1 draw call", m_Batch->GetMeshCount(), m_Batch->GetInstanceCount());
+	ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
+
+bool test::TestMultiDrawIndirect::RunCullCheck()
+{
+	if (!IndirectBatch::IsSupported())
+	{
+		std::cout << "[Cull check] FAILED: requires OpenGL 4.3 with vertex shader storage blocks" << std::endl;
+		return false;
+	}
+
+	IndirectBatch batch;
+	BuildScene(batch);
+	Shader cullShader("res/shaders/Cull.shader");
+
+	struct Camera
+	{
+		glm::vec3 Position;
+		float Zoom;
+		bool FrustumCulling;
+	};
+	// Part of the world, a wider part, all of it, none of it and culling off
+	const Camera cameras[] = {
+		{ { 0.0f, 0.0f, 0.0f }, 1.0f, true },
+		{ { 9000.0f, 5000.0f, 0.0f }, 0.25f, true },
+		{ { 0.0f, 0.0f, 0.0f }, 0.02f, true },
+		{ { -5000.0f, -5000.0f, 0.0f }, 1.0f, true },
+		{ { 0.0f, 0.0f, 0.0f }, 1.0f, false },
+	};
+
+	glm::mat4 proj = glm::ortho<float>(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+	bool passed = true;
+	for (unsigned int i = 0; i < IM_ARRAYSIZE(cameras); i++)
+	{
+		const Camera& camera = cameras[i];
+		glm::mat4 viewProjection = CameraViewProjection(proj, camera.Position, camera.Zoom);
+		batch.Cull(cullShader, viewProjection, camera.FrustumCulling);
+
+		std::vector<unsigned int> gpuCounts = batch.ReadVisibleCounts();
+		std::vector<unsigned int> minCounts, maxCounts;
+		batch.CountVisible(viewProjection, camera.FrustumCulling, CULL_CHECK_TOLERANCE, minCounts, maxCounts);
+
+		for (unsigned int mesh = 0; mesh < gpuCounts.size(); mesh++)
+		{
+			bool match = gpuCounts[mesh] >= minCounts[mesh] && gpuCounts[mesh] <= maxCounts[mesh];
+			std::cout << "[Cull check] camera " << i << " mesh " << mesh << ": GPU " << gpuCounts[mesh] << ", CPU " << minCounts[mesh];
+			if (maxCounts[mesh] != minCounts[mesh])
+				std::cout << "-" << maxCounts[mesh];
+			std::cout << (match ? "" : "  MISMATCH") << std::endl;
+			passed = passed && match;
+		}
+	}
+
+	std::cout << "[Cull check] " << (passed ? "PASSED" : "FAILED") << std::endl;
+	return passed;
+}
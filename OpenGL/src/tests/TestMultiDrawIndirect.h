@@ -0,0 +1,41 @@
+#pragma once
+#include "Test.h"
+#include <memory>
+#include "glm/glm.hpp"
+
+class IndirectBatch;
+class Shader;
+class Texture;
+
+namespace test
+{
+	// Scatters a large number of instances of a few meshes over a world much
+	// bigger than the screen, culls them with a compute shader and draws them
+	// all with one glMultiDrawElementsIndirect call
+	class TestMultiDrawIndirect : public Test
+	{
+	public:
+		TestMultiDrawIndirect();
+		~TestMultiDrawIndirect();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+
+		// Non interactive: culls the same scene from a few fixed cameras,
+		// reads back the instance counts the compute shader wrote and
+		// compares them with a CPU count. Prints the results and returns
+		// false on any mismatch or when GL 4.3 isn't available
+		static bool RunCullCheck();
+	private:
+		std::unique_ptr<IndirectBatch> m_Batch;
+		std::unique_ptr<Shader> m_CullShader;
+		std::unique_ptr<Shader> m_Shader;
+		std::unique_ptr<Texture> m_Texture;
+
+		glm::mat4 m_Proj;
+		glm::vec3 m_CameraPosition;
+		float m_Zoom;
+		bool m_FrustumCulling;
+	};
+}
@@ -0,0 +1,77 @@
+#include "TestParticles.h"
+#include <GL/glew.h>
+#include <chrono>
+#include "../Renderer.h"
+#include "imgui/imgui.h"
+#include "glm/gtc/matrix_transform.hpp"
+
+static const unsigned int PARTICLE_COUNTS[] = { 10000, 100000, 1000000 };
+static const char* PARTICLE_COUNT_NAMES[] = { "10k", "100k", "1M" };
+static const char* BACKEND_NAMES[] = { "Compute", "Transform feedback", "CPU (SIMD)" };
+
+test::TestParticles::TestParticles()
+	: m_Proj(glm::ortho<float>(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f))
+	, m_Backend((int)ParticleBackend::Compute)
+	, m_CountIndex(2)
+	, m_UpdateMilliseconds(0.0f)
+{
+	if (!ParticleSystem::IsSupported(ParticleBackend::Compute))
+		m_Backend = (int)ParticleBackend::TransformFeedback;
+	Recreate();
+}
+
+test::TestParticles::~TestParticles()
+{
+}
+
+void test::TestParticles::Recreate()
+{
+	m_Particles = std::make_unique<ParticleSystem>(PARTICLE_COUNTS[m_CountIndex], (ParticleBackend)m_Backend);
+}
+
+void test::TestParticles::OnUpdate(float deltaTime)
+{
+	// Large hitches would fling every particle across the screen
+	deltaTime = glm::min(deltaTime, 0.05f);
+
+	// Only meaningful for the CPU backend, the GPU ones just record commands
+	auto start = std::chrono::high_resolution_clock::now();
+	m_Particles->Update(deltaTime);
+	auto end = std::chrono::high_resolution_clock::now();
+	m_UpdateMilliseconds = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void test::TestParticles::OnRender()
+{
+	GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+	GLCall(glClear(GL_COLOR_BUFFER_BIT));
+	m_Particles->Render(m_Proj);
+}
+
+void test::TestParticles::OnImGuiRender()
+{
+	int backend = m_Backend;
+	int countIndex = m_CountIndex;
+	ImGui::Combo("Backend", &backend, BACKEND_NAMES, IM_ARRAYSIZE(BACKEND_NAMES));
+	ImGui::Combo("Particles", &countIndex, PARTICLE_COUNT_NAMES, IM_ARRAYSIZE(PARTICLE_COUNT_NAMES));
+	if (!ParticleSystem::IsSupported((ParticleBackend)backend))
+	{
+		ImGui::Text("Compute requires OpenGL 4.3");
+		backend = m_Backend;
+	}
+	if (backend != m_Backend || countIndex != m_CountIndex)
+	{
+		m_Backend = backend;
+		m_CountIndex = countIndex;
+		Recreate();
+	}
+
+	ImGui::SliderFloat2("Emitter", &m_Particles->Emitter.x, 0.0f, 960.0f);
+	ImGui::SliderFloat("Gravity", &m_Particles->Gravity.y, -1000.0f, 0.0f);
+	ImGui::SliderFloat("Speed", &m_Particles->Speed, 0.0f, 1000.0f);
+	ImGui::SliderFloat("Lifetime", &m_Particles->Lifetime, 0.1f, 10.0f);
+	ImGui::SliderFloat("Size", &m_Particles->Size, 1.0f, 8.0f);
+
+	ImGui::Text("Update (CPU side) %.3f ms", m_UpdateMilliseconds);
+	ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
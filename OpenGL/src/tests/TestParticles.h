@@ -0,0 +1,29 @@
+#pragma once
+#include "Test.h"
+#include <memory>
+#include "glm/glm.hpp"
+#include "../ParticleSystem.h"
+
+namespace test
+{
+	// Particle fountain that can be switched between the compute, transform
+	// feedback and CPU SIMD backends to compare them at different counts
+	class TestParticles : public Test
+	{
+	public:
+		TestParticles();
+		~TestParticles();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		void Recreate();
+
+		std::unique_ptr<ParticleSystem> m_Particles;
+		glm::mat4 m_Proj;
+		int m_Backend;
+		int m_CountIndex;
+		float m_UpdateMilliseconds;
+	};
+}
@@ -0,0 +1,95 @@
+#include "TestResourceManager.h"
+#include <GL/glew.h>
+#include "../Renderer.h"
+#include "../VertexBuffer.h"
+#include "../VertexBufferLayout.h"
+#include "../IndexBuffer.h"
+#include "../VertexArray.h"
+#include "../DeletionQueue.h"
+#include "imgui/imgui.h"
+#include "glm/gtc/matrix_transform.hpp"
+
+test::TestResourceManager::TestResourceManager()
+	: m_TextureBudgetKB(64 * 1024)
+	, m_DrawTexture(true)
+{
+	float positions[] = {
+		-50.0f, -50.0f, 0.0f, 0.0f,
+		 50.0f, -50.0f, 1.0f, 0.0f,
+		 50.0f,  50.0f, 1.0f, 1.0f,
+		-50.0f,  50.0f, 0.0f, 1.0f,
+	};
+
+	unsigned indices[] = {
+		0, 1, 2,
+		2, 3, 0,
+	};
+
+	m_VAO = std::make_unique<VertexArray>();
+	m_VertexBuffer = std::make_unique<VertexBuffer>(positions, 4 * 4 * sizeof(float));
+
+	VertexBufferLayout layout;
+	layout.Push<float>(2);
+	layout.Push<float>(2);
+	m_VAO->AddBuffer(*m_VertexBuffer, layout);
+
+	m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+	// The second loads of each resolve to the first
+	m_TextureA = m_Resources.LoadTexture("res/textures/ChernoLogo.png");
+	m_TextureB = m_Resources.LoadTexture("res\\shaders\\..\\textures\\.\\ChernoLogo.png");
+	m_ShaderA = m_Resources.LoadShader("res/shaders/Basic.shader");
+	m_ShaderB = m_Resources.LoadShader("./res/shaders/Basic.shader");
+}
+
+test::TestResourceManager::~TestResourceManager()
+{
+	m_Resources.Release(m_TextureA);
+	m_Resources.Release(m_TextureB);
+	m_Resources.Release(m_ShaderA);
+	m_Resources.Release(m_ShaderB);
+}
+
+void test::TestResourceManager::OnUpdate(float deltaTime)
+{
+	m_Resources.SetTextureBudget((size_t)m_TextureBudgetKB * 1024);
+	m_Resources.NewFrame();
+}
+
+void test::TestResourceManager::OnRender()
+{
+	if (!m_DrawTexture)
+		return;
+
+	Texture* texture = m_Resources.Get(m_TextureA);
+	Shader* shader = m_Resources.Get(m_ShaderA);
+	if (!texture || !shader)
+		return;
+
+	glm::mat4 proj = glm::ortho<float>(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(480.0f, 270.0f, 0.0f));
+
+	texture->Bind();
+	shader->Bind();
+	shader->SetUniform1i("u_Texture", 0);
+	shader->SetUniformMat4f("u_MVP", proj * model);
+
+	Renderer renderer;
+	renderer.Draw(*m_VAO, *m_IndexBuffer, *shader);
+}
+
+void test::TestResourceManager::OnImGuiRender()
+{
+	ImGui::Checkbox("Draw texture", &m_DrawTexture);
+	ImGui::SliderInt("Texture budget (KB)", &m_TextureBudgetKB, 0, 64 * 1024);
+
+	ImGui::Text("Texture handles: %u/%u and %u/%u", m_TextureA.Index, m_TextureA.Generation, m_TextureB.Index, m_TextureB.Generation);
+	ImGui::Text("Shader handles: %u/%u and %u/%u", m_ShaderA.Index, m_ShaderA.Generation, m_ShaderB.Index, m_ShaderB.Generation);
+	ImGui::Text("Textures loaded: %u (%.1f KB)", m_Resources.GetLoadedCount(ResourceType::Texture),
+		m_Resources.GetMemoryUsage(ResourceType::Texture) / 1024.0f);
+	ImGui::Text("Shaders loaded: %u (%.1f KB)", m_Resources.GetLoadedCount(ResourceType::Shader),
+		m_Resources.GetMemoryUsage(ResourceType::Shader) / 1024.0f);
+	ImGui::Text("Evictions: %u", m_Resources.GetEvictionCount());
+	// Evicted textures sit here until the GPU has finished the frames that used them
+	ImGui::Text("GL objects awaiting deletion: %u", DeletionQueue::GetPendingCount());
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Test.h"
+#include <memory>
+#include "../ResourceManager.h"
+
+class VertexArray;
+class VertexBuffer;
+class IndexBuffer;
+
+namespace test
+{
+	// Loads the same texture and shader twice through the ResourceManager to
+	// show deduplication, and lets the texture budget be lowered to watch
+	// unused textures get evicted and reloaded on demand, their GL objects
+	// going through the deferred DeletionQueue
+	class TestResourceManager : public Test
+	{
+	public:
+		TestResourceManager();
+		~TestResourceManager();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		ResourceManager m_Resources;
+		TextureHandle m_TextureA;
+		TextureHandle m_TextureB;
+		ShaderHandle m_ShaderA;
+		ShaderHandle m_ShaderB;
+
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<VertexBuffer> m_VertexBuffer;
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+
+		int m_TextureBudgetKB;
+		bool m_DrawTexture;
+	};
+}
@@ -0,0 +1,104 @@
+#include "TestText.h"
+#include <GL/glew.h>
+#include <fstream>
+#include <string>
+#include "../Renderer.h"
+#include "../Font.h"
+#include "../TextRenderer.h"
+#include "imgui/imgui.h"
+#include "glm/gtc/matrix_transform.hpp"
+
+static const unsigned int LABEL_COLUMNS = 40;
+static const unsigned int LABEL_ROWS = 60;
+
+// No font ships with the repo, use the first one found
+static const char* FONT_PATHS[] = {
+	"res/fonts/font.ttf",
+	"C:/Windows/Fonts/segoeui.ttf",
+	"C:/Windows/Fonts/arial.ttf",
+	"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+};
+
+test::TestText::TestText()
+	: m_Proj(glm::ortho<float>(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f))
+	, m_Title(0)
+	, m_Clock(0)
+	, m_Time(0.0f)
+	, m_LastSecond(-1)
+	, m_TitleSize(48.0f)
+	, m_TitleColor{ 1.0f, 1.0f, 1.0f, 1.0f }
+	, m_TitleText("Signed distance field text")
+{
+	for (const char* path : FONT_PATHS)
+	{
+		if (std::ifstream(path).good())
+		{
+			m_Font = std::make_unique<Font>(path);
+			break;
+		}
+	}
+	if (!m_Font || !m_Font->IsLoaded())
+		return;
+
+	m_Text = std::make_unique<TextRenderer>(*m_Font, 64 * 1024);
+
+	for (unsigned int row = 0; row < LABEL_ROWS; row++)
+	{
+		for (unsigned int column = 0; column < LABEL_COLUMNS; column++)
+		{
+			glm::vec2 position(column * 24.0f, row * 9.0f);
+			glm::vec4 color(column / (float)LABEL_COLUMNS, row / (float)LABEL_ROWS, 0.8f, 0.6f);
+			m_Text->AddText("L" + std::to_string(row * LABEL_COLUMNS + column), position, 8.0f, color);
+		}
+	}
+
+	m_Title = m_Text->AddText(m_TitleText, glm::vec2(20.0f, 470.0f), m_TitleSize, glm::vec4(1.0f));
+	m_Clock = m_Text->AddText("", glm::vec2(20.0f, 430.0f), 24.0f, glm::vec4(1.0f, 0.8f, 0.2f, 1.0f));
+}
+
+test::TestText::~TestText()
+{
+}
+
+void test::TestText::OnUpdate(float deltaTime)
+{
+	if (!m_Text)
+		return;
+
+	// Only re-laid out once a second, when the string actually changes
+	m_Time += deltaTime;
+	if ((int)m_Time != m_LastSecond)
+	{
+		m_LastSecond = (int)m_Time;
+		m_Text->SetText(m_Clock, "Running for " + std::to_string(m_LastSecond) + "s");
+	}
+}
+
+void test::TestText::OnRender()
+{
+	GLCall(glClearColor(0.1f, 0.1f, 0.12f, 1.0f));
+	GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+	if (m_Text)
+		m_Text->Render(m_Proj);
+}
+
+void test::TestText::OnImGuiRender()
+{
+	if (!m_Text)
+	{
+		ImGui::Text("No font found, put a TrueType font at res/fonts/font.ttf");
+		return;
+	}
+
+	if (ImGui::InputText("Title", m_TitleText, sizeof(m_TitleText)))
+		m_Text->SetText(m_Title, m_TitleText);
+	if (ImGui::SliderFloat("Title size", &m_TitleSize, 8.0f, 200.0f))
+		m_Text->SetSize(m_Title, m_TitleSize);
+	if (ImGui::ColorEdit4("Title color", m_TitleColor))
+		m_Text->SetColor(m_Title, glm::vec4(m_TitleColor[0], m_TitleColor[1], m_TitleColor[2], m_TitleColor[3]));
+
+	ImGui::Text("%u glyphs in %u labels, 1 draw call", m_Text->GetUsedGlyphs(), LABEL_ROWS * LABEL_COLUMNS + 2);
+	ImGui::Text("Layouts so far: %u", m_Text->GetLayoutCount());
+	ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Test.h"
+#include <memory>
+#include "glm/glm.hpp"
+
+class Font;
+class TextRenderer;
+
+namespace test
+{
+	// Thousands of static SDF labels plus a few that change, all drawn in
+	// one call. The layout counter shows only the changing runs are re-laid out
+	class TestText : public Test
+	{
+	public:
+		TestText();
+		~TestText();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		std::unique_ptr<Font> m_Font;
+		std::unique_ptr<TextRenderer> m_Text;
+		glm::mat4 m_Proj;
+
+		unsigned int m_Title;
+		unsigned int m_Clock;
+		float m_Time;
+		int m_LastSecond;
+		float m_TitleSize;
+		float m_TitleColor[4];
+		char m_TitleText[128];
+	};
+}